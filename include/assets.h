@@ -3,6 +3,10 @@
  * @file   assets.h
  * @author Stéphane Calderoni (https://github.com/m1cr0lab)
  * @brief  Graphics assets
+ *
+ * @note Generated by tools/assets.py from the images in assets/src,
+ *       do not edit by hand. The formats are described in the generator
+ *       and decoded by the `Blitter`.
  * -----------------------------------------------------------------------------
  */
 
@@ -13,7 +17,45 @@
 uint8_t  constexpr M1CR0LAB_SIZE        = 38;
 uint16_t constexpr M1CR0LAB_TRANS_COLOR = 0x1ff8;
 
-uint16_t const constexpr M1CR0LAB[] PROGMEM = {
+uint16_t const constexpr M1CR0LAB_PALETTE[] PROGMEM = {
+
+    0x1ff8, 0x8f42, 0xd56b, 0x5fb6, 0xa8c3, 0xccfd, 0x4eff, 0x0000,
+    0x2572, 0xffff
+
+};
+
+uint8_t const constexpr M1CR0LAB[] PROGMEM = {
+
+    0x50, 0x31, 0xf0, 0x10, 0x31, 0x12, 0x90, 0x31, 0xf0, 0x10, 0x31, 0x12, 0x70, 0x12, 0x30, 0x11,
+    0xd0, 0x11, 0x30, 0x11, 0x12, 0x50, 0x12, 0x30, 0x11, 0xd0, 0x11, 0x30, 0x11, 0x12, 0x30, 0x12,
+    0x11, 0x50, 0x11, 0x90, 0x11, 0x50, 0x11, 0x13, 0x30, 0x12, 0x11, 0x50, 0x11, 0x90, 0x11, 0x50,
+    0x11, 0x13, 0x30, 0x13, 0x11, 0x30, 0x14, 0x15, 0x32, 0x51, 0x15, 0x14, 0x30, 0x11, 0x13, 0x30,
+    0x13, 0x11, 0x30, 0x14, 0x15, 0x32, 0x51, 0x15, 0x14, 0x30, 0x11, 0x13, 0x30, 0x13, 0x11, 0x10,
+    0x72, 0x55, 0x71, 0x10, 0x11, 0x12, 0x30, 0x13, 0x11, 0x10, 0x72, 0x55, 0x71, 0x10, 0x11, 0x12,
+    0x30, 0x12, 0x11, 0x10, 0x55, 0x12, 0x16, 0x35, 0x11, 0x15, 0x34, 0x90, 0x12, 0x11, 0x10, 0x55,
+    0x12, 0x16, 0x35, 0x11, 0x15, 0x34, 0xf0, 0x31, 0x15, 0x12, 0x71, 0x15, 0x31, 0xf0, 0x31, 0x15,
+    0x12, 0x71, 0x15, 0x31, 0xf0, 0x11, 0x13, 0x11, 0x15, 0x16, 0x35, 0x14, 0x11, 0x13, 0x11, 0xf0,
+    0x11, 0x13, 0x11, 0x15, 0x16, 0x35, 0x14, 0x11, 0x13, 0x11, 0xf0, 0x11, 0x12, 0x11, 0x15, 0x16,
+    0x35, 0x14, 0x11, 0x12, 0x11, 0xf0, 0x11, 0x12, 0x11, 0x15, 0x16, 0x35, 0x14, 0x11, 0x12, 0x11,
+    0xf0, 0x14, 0x31, 0x14, 0x17, 0x15, 0x17, 0x14, 0x31, 0x14, 0xf0, 0x14, 0x31, 0x14, 0x17, 0x15,
+    0x17, 0x14, 0x31, 0x14, 0xf0, 0x10, 0x14, 0x18, 0x94, 0x18, 0x14, 0xf0, 0x30, 0x14, 0x18, 0x94,
+    0x18, 0x14, 0xf0, 0x50, 0x14, 0x35, 0x14, 0x35, 0x14, 0xf0, 0x70, 0x14, 0x35, 0x14, 0x35, 0x14,
+    0xf0, 0x70, 0x54, 0x18, 0x54, 0xf0, 0x70, 0x54, 0x18, 0x54, 0xf0, 0x90, 0x34, 0x10, 0x34, 0xf0,
+    0xb0, 0x34, 0x10, 0x34, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+    0xb0, 0x39, 0x10, 0x19, 0x10, 0x29, 0x00, 0x29, 0x20, 0x29, 0x10, 0x09, 0x30, 0x19, 0x10, 0x29,
+    0x00, 0x09, 0x00, 0x09, 0x00, 0x09, 0x10, 0x09, 0x00, 0x09, 0x30, 0x09, 0x10, 0x09, 0x00, 0x09,
+    0x20, 0x09, 0x00, 0x09, 0x20, 0x09, 0x10, 0x09, 0x00, 0x09, 0x10, 0x19, 0x00, 0x09, 0x00, 0x09,
+    0x10, 0x09, 0x00, 0x09, 0x30, 0x29, 0x10, 0x09, 0x20, 0x09, 0x00, 0x09, 0x20, 0x39, 0x00, 0x29,
+    0x00, 0x09, 0x00, 0x09, 0x00, 0x09, 0x10, 0x09, 0x00, 0x09, 0x30, 0x09, 0x10, 0x09, 0x00, 0x09,
+    0x20, 0x09, 0x00, 0x09, 0x20, 0x09, 0x10, 0x09, 0x00, 0x09, 0x10, 0x19, 0x20, 0x09, 0x10, 0x09,
+    0x10, 0x29, 0x00, 0x09, 0x10, 0x09, 0x10, 0x29, 0x10, 0x29, 0x00, 0x09, 0x10, 0x09, 0x00, 0x29,
+    0x00
+
+};
+
+#ifdef ASSETS_RAW
+
+uint16_t const constexpr M1CR0LAB_RAW[] PROGMEM = {
 
     0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x8f42, 0x8f42, 0x8f42, 0x8f42, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x8f42, 0x8f42, 0x8f42, 0x8f42, 0xd56b, 0xd56b, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8,
     0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x8f42, 0x8f42, 0x8f42, 0x8f42, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8, 0x8f42, 0x8f42, 0x8f42, 0x8f42, 0xd56b, 0xd56b, 0x1ff8, 0x1ff8, 0x1ff8, 0x1ff8,
@@ -56,10 +98,47 @@ uint16_t const constexpr M1CR0LAB[] PROGMEM = {
 
 };
 
+#endif
+
 uint8_t constexpr TILE_SIZE = 27;
 
 uint8_t const constexpr TILE[] PROGMEM = {
 
+    0x00, 0x1b,
+    0x01, 0x01, 0x19,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x00, 0x1b,
+    0x01, 0x01, 0x19
+
+};
+
+#ifdef ASSETS_RAW
+
+uint8_t const constexpr TILE_RAW[] PROGMEM = {
+
     0x7f, 0xff, 0xff, 0xc0,
     0xff, 0xff, 0xff, 0xe0,
     0xff, 0xff, 0xff, 0xe0,
@@ -90,12 +169,46 @@ uint8_t const constexpr TILE[] PROGMEM = {
 
 };
 
-uint8_t constexpr POWER_OF_TWO_WIDTH      = 23;
-uint8_t constexpr POWER_OF_TWO_HEIGHT     = 17;
-uint8_t constexpr POWER_OF_TWO_FRAME_SIZE = ((POWER_OF_TWO_WIDTH + 1) >> 3) * POWER_OF_TWO_HEIGHT;
+#endif
+
+uint8_t constexpr POWER_OF_TWO_WIDTH  = 23;
+uint8_t constexpr POWER_OF_TWO_HEIGHT = 17;
+
+uint16_t const constexpr POWER_OF_TWO_OFFSET[] PROGMEM = {
+
+    0x0000, 0x0017, 0x002e, 0x0045, 0x005c, 0x0073, 0x008a, 0x00a1, 0x00b8,
+    0x00cf, 0x00e6, 0x00fd, 0x0114, 0x012b, 0x0160, 0x0195, 0x01ca
+
+};
 
 uint8_t const constexpr POWER_OF_TWO[] PROGMEM = {
 
+    /*      2 */ 0x05, 0x07, 0x00, 0x38, 0x00, 0x00, 0x44, 0x00, 0x00, 0x04, 0x00, 0x00, 0x38, 0x00, 0x00, 0x40, 0x00, 0x00, 0x40, 0x00, 0x00, 0x7c, 0x00,
+    /*      4 */ 0x05, 0x07, 0x00, 0x08, 0x00, 0x00, 0x18, 0x00, 0x00, 0x28, 0x00, 0x00, 0x48, 0x00, 0x00, 0x7c, 0x00, 0x00, 0x08, 0x00, 0x00, 0x08, 0x00,
+    /*      8 */ 0x05, 0x07, 0x00, 0x38, 0x00, 0x00, 0x44, 0x00, 0x00, 0x44, 0x00, 0x00, 0x38, 0x00, 0x00, 0x44, 0x00, 0x00, 0x44, 0x00, 0x00, 0x38, 0x00,
+    /*     16 */ 0x05, 0x07, 0x00, 0x87, 0x00, 0x01, 0x88, 0x00, 0x00, 0x90, 0x00, 0x00, 0x9e, 0x00, 0x00, 0x91, 0x00, 0x00, 0x91, 0x00, 0x01, 0xce, 0x00,
+    /*     32 */ 0x05, 0x07, 0x03, 0xe7, 0x00, 0x00, 0x28, 0x80, 0x00, 0x40, 0x80, 0x00, 0xe7, 0x00, 0x00, 0x28, 0x00, 0x02, 0x28, 0x00, 0x01, 0xcf, 0x80,
+    /*     64 */ 0x05, 0x07, 0x00, 0xe1, 0x00, 0x01, 0x03, 0x00, 0x02, 0x05, 0x00, 0x03, 0xc9, 0x00, 0x02, 0x2f, 0x80, 0x02, 0x21, 0x00, 0x01, 0xc1, 0x00,
+    /*    128 */ 0x05, 0x07, 0x04, 0x71, 0xc0, 0x0c, 0x8a, 0x20, 0x04, 0x0a, 0x20, 0x04, 0x71, 0xc0, 0x04, 0x82, 0x20, 0x04, 0x82, 0x20, 0x0e, 0xf9, 0xc0,
+    /*    256 */ 0x05, 0x07, 0x0e, 0x7c, 0x70, 0x11, 0x40, 0x80, 0x01, 0x79, 0x00, 0x0e, 0x05, 0xe0, 0x10, 0x05, 0x10, 0x10, 0x45, 0x10, 0x1f, 0x38, 0xe0,
+    /*    512 */ 0x05, 0x07, 0x0f, 0x91, 0xc0, 0x08, 0x32, 0x20, 0x0f, 0x10, 0x20, 0x00, 0x91, 0xc0, 0x00, 0x92, 0x00, 0x08, 0x92, 0x00, 0x07, 0x3b, 0xe0,
+    /*   1024 */ 0x05, 0x07, 0x23, 0x8e, 0x08, 0x64, 0x51, 0x18, 0x24, 0xc1, 0x28, 0x25, 0x4e, 0x48, 0x26, 0x50, 0x7c, 0x24, 0x50, 0x08, 0x73, 0x9f, 0x08,
+    /*   2048 */ 0x05, 0x07, 0x71, 0xc1, 0x1c, 0x8a, 0x23, 0x22, 0x0a, 0x65, 0x22, 0x72, 0xa9, 0x1c, 0x83, 0x2f, 0xa2, 0x82, 0x21, 0x22, 0xf9, 0xc1, 0x1c,
+    /*   4096 */ 0x05, 0x07, 0x11, 0xc7, 0x0e, 0x32, 0x28, 0x90, 0x52, 0x68, 0xa0, 0x92, 0xa7, 0xbc, 0xfb, 0x20, 0xa2, 0x12, 0x21, 0x22, 0x11, 0xce, 0x1c,
+    /*   8192 */ 0x05, 0x07, 0x38, 0x8e, 0x38, 0x45, 0x91, 0x44, 0x44, 0x91, 0x04, 0x38, 0x8f, 0x38, 0x44, 0x81, 0x40, 0x44, 0x82, 0x40, 0x39, 0xdc, 0x7c,
+    /*  16384 */ 0x00, 0x11, 0x00, 0x87, 0x00, 0x01, 0x88, 0x00, 0x00, 0x90, 0x00, 0x00, 0x9e, 0x00, 0x00, 0x91, 0x00, 0x00, 0x91, 0x00, 0x01, 0xce, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x38, 0x20, 0x01, 0x44, 0x60, 0x02, 0x44, 0xa0, 0x07, 0x39, 0x20, 0x01, 0x45, 0xf0, 0x11, 0x44, 0x20, 0x0e, 0x38, 0x20,
+    /*  32768 */ 0x00, 0x11, 0x03, 0xe7, 0x00, 0x00, 0x28, 0x80, 0x00, 0x40, 0x80, 0x00, 0xe7, 0x00, 0x00, 0x28, 0x00, 0x02, 0x28, 0x00, 0x01, 0xcf, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x1c, 0xe0, 0x01, 0x21, 0x10, 0x01, 0x41, 0x10, 0x02, 0x78, 0xe0, 0x04, 0x45, 0x10, 0x08, 0x45, 0x10, 0x10, 0x38, 0xe0,
+    /*  65536 */ 0x00, 0x11, 0x00, 0xef, 0x80, 0x01, 0x08, 0x00, 0x02, 0x0f, 0x00, 0x03, 0xc0, 0x80, 0x02, 0x20, 0x80, 0x02, 0x28, 0x80, 0x01, 0xc7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x7c, 0x70, 0x10, 0x04, 0x80, 0x1e, 0x09, 0x00, 0x01, 0x1d, 0xe0, 0x01, 0x05, 0x10, 0x11, 0x45, 0x10, 0x0e, 0x38, 0xe0,
+    /* 131072 */ 0x00, 0x11, 0x02, 0x7c, 0x80, 0x06, 0x05, 0x80, 0x02, 0x08, 0x80, 0x02, 0x1c, 0x80, 0x02, 0x04, 0x80, 0x02, 0x44, 0x80, 0x07, 0x39, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x7c, 0xe0, 0x11, 0x05, 0x10, 0x13, 0x04, 0x10, 0x15, 0x08, 0xe0, 0x19, 0x11, 0x00, 0x11, 0x21, 0x00, 0x0e, 0x41, 0xf0
+
+};
+
+#ifdef ASSETS_RAW
+
+uint8_t constexpr POWER_OF_TWO_FRAME_SIZE = 51;
+
+uint8_t const constexpr POWER_OF_TWO_RAW[] PROGMEM = {
+
     /*      2 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x44, 0x00, 0x00, 0x04, 0x00, 0x00, 0x38, 0x00, 0x00, 0x40, 0x00, 0x00, 0x40, 0x00, 0x00, 0x7c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
     /*      4 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x18, 0x00, 0x00, 0x28, 0x00, 0x00, 0x48, 0x00, 0x00, 0x7c, 0x00, 0x00, 0x08, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
     /*      8 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x44, 0x00, 0x00, 0x44, 0x00, 0x00, 0x38, 0x00, 0x00, 0x44, 0x00, 0x00, 0x44, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -112,37 +225,39 @@ uint8_t const constexpr POWER_OF_TWO[] PROGMEM = {
     /*  16384 */ 0x00, 0x87, 0x00, 0x01, 0x88, 0x00, 0x00, 0x90, 0x00, 0x00, 0x9e, 0x00, 0x00, 0x91, 0x00, 0x00, 0x91, 0x00, 0x01, 0xce, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x38, 0x20, 0x01, 0x44, 0x60, 0x02, 0x44, 0xa0, 0x07, 0x39, 0x20, 0x01, 0x45, 0xf0, 0x11, 0x44, 0x20, 0x0e, 0x38, 0x20,
     /*  32768 */ 0x03, 0xe7, 0x00, 0x00, 0x28, 0x80, 0x00, 0x40, 0x80, 0x00, 0xe7, 0x00, 0x00, 0x28, 0x00, 0x02, 0x28, 0x00, 0x01, 0xcf, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x1c, 0xe0, 0x01, 0x21, 0x10, 0x01, 0x41, 0x10, 0x02, 0x78, 0xe0, 0x04, 0x45, 0x10, 0x08, 0x45, 0x10, 0x10, 0x38, 0xe0,
     /*  65536 */ 0x00, 0xef, 0x80, 0x01, 0x08, 0x00, 0x02, 0x0f, 0x00, 0x03, 0xc0, 0x80, 0x02, 0x20, 0x80, 0x02, 0x28, 0x80, 0x01, 0xc7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x7c, 0x70, 0x10, 0x04, 0x80, 0x1e, 0x09, 0x00, 0x01, 0x1d, 0xe0, 0x01, 0x05, 0x10, 0x11, 0x45, 0x10, 0x0e, 0x38, 0xe0,
-    /* 131072 */ 0x02, 0x7c, 0x80, 0x06, 0x05, 0x80, 0x02, 0x08, 0x80, 0x02, 0x1c, 0x80, 0x02, 0x04, 0x80, 0x02, 0x44, 0x80, 0x07, 0x39, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x7c, 0xe0, 0x11, 0x05, 0x10, 0x13, 0x04, 0x10, 0x15, 0x08, 0xe0, 0x19, 0x11, 0x00, 0x11, 0x21, 0x00, 0x0e, 0x41, 0xf0,
+    /* 131072 */ 0x02, 0x7c, 0x80, 0x06, 0x05, 0x80, 0x02, 0x08, 0x80, 0x02, 0x1c, 0x80, 0x02, 0x04, 0x80, 0x02, 0x44, 0x80, 0x07, 0x39, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x7c, 0xe0, 0x11, 0x05, 0x10, 0x13, 0x04, 0x10, 0x15, 0x08, 0xe0, 0x19, 0x11, 0x00, 0x11, 0x21, 0x00, 0x0e, 0x41, 0xf0
 
 };
 
+#endif
+
 uint8_t constexpr PALETTE_SIZE = 22;
 
 uint16_t const constexpr PALETTE[] PROGMEM = {
 
-    0xce16, //      0 => hsl( 34,  18,  76)
-    0xef19, //      2 => hsl( 40,  40,  86)
-    0xe6b6, //      4 => hsl( 40,  46,  80)
-    0xfe77, //      8 => hsl( 20, 100,  86)
-    0xfdf3, //     16 => hsl( 20,  90,  80)
-    0xfcf1, //     32 => hsl( 10,  90,  76)
-    0xfc30, //     64 => hsl(  0, 100,  76)
-    0xffb3, //    128 => hsl( 55, 100,  80)
-    0xff66, //    256 => hsl( 55, 100,  60)
-    0xfee6, //    512 => hsl( 50, 100,  60)
-    0xfe66, //   1024 => hsl( 45, 100,  60)
-    0xfdc6, //   2048 => hsl( 40, 100,  60)
-    0x37f7, //   4096 => hsl(160, 100,  60)
-    0x4796, //   8192 => hsl(160,  87,  60)
-    0x4f34, //  16384 => hsl(154,  75,  60)
-    0x5ed3, //  32768 => hsl(152,  62,  60)
-    0x0f9e, //  65536 => hsl(180,  90,  50)
-    0x1f3c, // 131072 => hsl(180,  80,  50)
-
-    0xb553, // background => hsl(30, 14, 66)
-    0x7b8c, // dark       => hsl(32,  8, 44)
-    0xffff, // light      => white
-    0x0000  // black      => black
+    0xce16, //          0 => #cec3b5
+    0xef19, //          2 => #efe3ce
+    0xe6b6, //          4 => #e7d7b5
+    0xfe77, //          8 => #ffcfbd
+    0xfdf3, //         16 => #ffbe9c
+    0xfcf1, //         32 => #ff9e8c
+    0xfc30, //         64 => #ff8684
+    0xffb3, //        128 => #fff79c
+    0xff66, //        256 => #ffef31
+    0xfee6, //        512 => #ffdf31
+    0xfe66, //       1024 => #ffcf31
+    0xfdc6, //       2048 => #ffba31
+    0x37f7, //       4096 => #31ffbd
+    0x4796, //       8192 => #42f3b5
+    0x4f34, //      16384 => #4ae7a5
+    0x5ed3, //      32768 => #5adb9c
+    0x0f9e, //      65536 => #08f3f7
+    0x1f3c, //     131072 => #18e7e7
+
+    0xb553, // background => #b5aa9c
+    0x7b8c, //       dark => #7b7163
+    0xffff, //      light => #ffffff
+    0x0000  //      black => #000000
 
 };
 
@@ -0,0 +1,93 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Arduino.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Host stand-in for the subset of the Arduino core used by the game
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#define PROGMEM
+
+#define pgm_read_byte(addr)  (*(uint8_t  const *)(addr))
+#define pgm_read_word(addr)  (*(uint16_t const *)(addr))
+#define pgm_read_dword(addr) (*(uint32_t const *)(addr))
+
+using std::min;
+using std::max;
+
+class __FlashStringHelper;
+
+#define F(string_literal) (reinterpret_cast<__FlashStringHelper const *>(string_literal))
+
+uint32_t millis();
+uint32_t micros();
+void     delay(uint32_t const ms);
+
+long random(long const max);
+long random(long const min, long const max);
+void randomSeed(unsigned long const seed);
+
+class EspClass {
+
+    public:
+
+        // Real host time rather than the virtual clock, scaled to the
+        // 80 MHz of the handheld so that both report the same unit.
+        uint32_t getCycleCount();
+
+};
+
+class HardwareSerial {
+
+    public:
+
+        void begin(unsigned long const baud) { (void)baud; }
+        int  available() { return 0; }
+        int  read()      { return -1; }
+
+        // Forwarded to the standard output.
+        size_t printf(char const *format, ...) __attribute__((format(printf, 2, 3)));
+
+};
+
+extern EspClass       ESP;
+extern HardwareSerial Serial;
+
+namespace host {
+
+    // The host clock is virtual: it only moves forward when the harness
+    // decides so, which lets the game run at full host speed.
+    void advance(uint32_t const us);
+
+}
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
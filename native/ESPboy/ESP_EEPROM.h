@@ -0,0 +1,78 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   ESP_EEPROM.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Host stand-in for the ESP_EEPROM library
+ *
+ * @note The emulated area lives in memory and starts blank, exactly like a
+ *       freshly flashed device. Commits are counted the way the library
+ *       spends its flash sector: each one takes the next free slot, and the
+ *       sector is only erased once every slot has been used. As with the
+ *       library, a record is only found back under the size it was committed
+ *       with.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+class EEPROMClass {
+
+    public:
+
+        uint32_t commits = 0;
+        uint32_t erases  = 0;
+
+        void begin(size_t const size);
+        void end() { _size = 0; }
+        int  percentUsed() const { return _slot && _size == _stored ? _slot * 100 / _slots() : -1; }
+        bool commit();
+
+        template <typename T> T &get(int const address, T &t) {
+            if (address >= 0 && address + sizeof(T) <= _size) memcpy(&t, _data + address, sizeof(T));
+            return t;
+        }
+
+        template <typename T> T const &put(int const address, T const &t) {
+            if (address >= 0 && address + sizeof(T) <= _size) memcpy(_data + address, &t, sizeof(T));
+            return t;
+        }
+
+    private:
+
+        static uint16_t constexpr _SECTOR = 4096;
+        static uint16_t constexpr _HEADER = 16;
+
+        uint8_t  _data[_SECTOR] = { 0 };
+        size_t   _size          = 0;
+        size_t   _stored        = 0; // size the last record was committed with
+        uint16_t _slot          = 0;
+
+        uint16_t _slots() const { return (_SECTOR - _HEADER) / ((_size + 3) & ~3); }
+
+};
+
+extern EEPROMClass EEPROM;
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
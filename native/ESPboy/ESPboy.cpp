@@ -0,0 +1,129 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   ESPboy.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Host stand-in for the ESPboy library and the Arduino core
+ * -----------------------------------------------------------------------------
+ */
+
+#include <ESPboy.h>
+#include <ESP_EEPROM.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <random>
+
+ESPboy         espboy;
+EEPROMClass    EEPROM;
+EspClass       ESP;
+HardwareSerial Serial;
+
+// -----------------------------------------------------------------------------
+// Arduino core
+// -----------------------------------------------------------------------------
+
+static uint64_t     _clock_us = 0;
+static std::mt19937 _rng;
+
+void host::advance(uint32_t const us) { _clock_us += us; }
+
+uint32_t millis() { return _clock_us / 1000; }
+uint32_t micros() { return _clock_us; }
+
+void delay(uint32_t const ms) { _clock_us += ms * 1000ULL; }
+
+long random(long const max) { return max > 0 ? _rng() % max : 0; }
+
+long random(long const min, long const max) { return min < max ? min + random(max - min) : min; }
+
+void randomSeed(unsigned long const seed) { _rng.seed(seed); }
+
+uint32_t EspClass::getCycleCount() {
+
+    using Clock = std::chrono::steady_clock;
+
+    uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+
+    return ns * 2 / 25;
+
+}
+
+size_t HardwareSerial::printf(char const *format, ...) {
+
+    va_list args;
+    va_start(args, format);
+    int n = vprintf(format, args);
+    va_end(args);
+
+    return n > 0 ? n : 0;
+
+}
+
+// -----------------------------------------------------------------------------
+// ESPboy
+// -----------------------------------------------------------------------------
+
+uint32_t Color::hsv2rgb(uint16_t const hue, uint8_t const sat, uint8_t const val) {
+
+    (void)hue; (void)sat;
+
+    return val << 16;
+
+}
+
+void ButtonController::update() {
+
+    uint8_t last = _state;
+
+    _state    = _pending;
+    _pending  = 0;
+    _pressed  = _state & ~last;
+    _released = last & ~_state;
+
+}
+
+// -----------------------------------------------------------------------------
+// ESP_EEPROM
+// -----------------------------------------------------------------------------
+
+void EEPROMClass::begin(size_t const size) {
+
+    _size = std::min(size, sizeof(_data));
+
+}
+
+bool EEPROMClass::commit() {
+
+    // A record of another size cannot be appended to the former ones.
+    if (_slot == _slots() || _size != _stored) { _slot = 0; erases += _stored != 0; }
+
+    _stored = _size;
+
+    _slot++;
+    commits++;
+
+    return true;
+
+}
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
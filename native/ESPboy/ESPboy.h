@@ -0,0 +1,116 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   ESPboy.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Host stand-in for the ESPboy library
+ *
+ * @note Only the handheld features the game relies on are mirrored here.
+ *       Button presses are injected by the host harness and are seen by
+ *       the game on the next call to `espboy.update()`, which also steps a
+ *       fade-out over a few calls, as the backlight of the handheld does.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "LovyanGFX.hpp"
+
+#define TFT_WIDTH  128
+#define TFT_HEIGHT 128
+
+enum class Button : uint8_t {
+    LEFT,
+    UP,
+    DOWN,
+    RIGHT,
+    ACT,
+    ESC,
+    LFT,
+    RGT
+};
+
+class Color {
+
+    public:
+
+        static uint32_t hsv2rgb(uint16_t const hue, uint8_t const sat = 255, uint8_t const val = 255);
+
+};
+
+class ButtonController {
+
+    public:
+
+        bool pressed(Button const b) const  { return _pressed  & _mask(b); }
+        bool released(Button const b) const { return _released & _mask(b); }
+        bool held(Button const b) const     { return _state    & _mask(b); }
+
+        void inject(Button const b) { _pending |= _mask(b); }
+        void update();
+
+    private:
+
+        uint8_t _state    = 0;
+        uint8_t _pressed  = 0;
+        uint8_t _released = 0;
+        uint8_t _pending  = 0;
+
+        static uint8_t _mask(Button const b) { return 1 << static_cast<uint8_t>(b); }
+
+};
+
+class NeoPixel {
+
+    public:
+
+        void flash(uint32_t, uint16_t, uint8_t = 1, uint16_t = 0) {}
+        void rainbow(uint16_t, uint8_t = 1) {}
+        void clear() {}
+
+};
+
+class ESPboy {
+
+    public:
+
+        LGFX             tft = LGFX(TFT_WIDTH, TFT_HEIGHT);
+        ButtonController button;
+        NeoPixel         pixel;
+
+        void begin() {}
+        void update() { button.update(); if (_fade) _fade--; }
+
+        void fadeIn()  {}
+        void fadeOut() { _fade = 16; }
+        bool fading()  { return _fade > 0; }
+
+    private:
+
+        uint8_t _fade = 0;
+
+};
+
+extern ESPboy espboy;
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
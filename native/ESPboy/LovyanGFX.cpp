@@ -0,0 +1,333 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   LovyanGFX.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Host stand-in for the subset of LovyanGFX used by the game
+ * -----------------------------------------------------------------------------
+ */
+
+#include "LovyanGFX.hpp"
+#include <algorithm>
+
+static uint16_t rgb565(uint32_t const rgb888) {
+
+    return ((rgb888 >> 8) & 0xf800) | ((rgb888 >> 5) & 0x07e0) | ((rgb888 >> 3) & 0x001f);
+
+}
+
+static uint16_t swap565(uint16_t const c) {
+
+    return c << 8 | c >> 8;
+
+}
+
+// -----------------------------------------------------------------------------
+// Common drawing primitives
+// -----------------------------------------------------------------------------
+
+void LovyanGFX::_resetClip(int32_t const w, int32_t const h) {
+
+    _width  = w;
+    _height = h;
+
+    clearClipRect();
+
+}
+
+void LovyanGFX::setClipRect(int32_t x, int32_t y, int32_t w, int32_t h) {
+
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+
+    _clip_l = x;
+    _clip_t = y;
+    _clip_r = std::min(x + w, _width)  - 1;
+    _clip_b = std::min(y + h, _height) - 1;
+
+}
+
+void LovyanGFX::getClipRect(int32_t *x, int32_t *y, int32_t *w, int32_t *h) const {
+
+    *x = _clip_l;
+    *y = _clip_t;
+    *w = _clip_r - _clip_l + 1;
+    *h = _clip_b - _clip_t + 1;
+
+}
+
+void LovyanGFX::clearClipRect() {
+
+    _clip_l = _clip_t = 0;
+    _clip_r = _width  - 1;
+    _clip_b = _height - 1;
+
+}
+
+void LovyanGFX::drawPixel(int32_t const x, int32_t const y, uint32_t const color) {
+
+    if (x < _clip_l || x > _clip_r || y < _clip_t || y > _clip_b) return;
+
+    _writePixel(x, y, color);
+
+}
+
+void LovyanGFX::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t const color) {
+
+    for (int32_t j = 0; j < h; ++j) {
+        for (int32_t i = 0; i < w; ++i) drawPixel(x + i, y + j, color);
+    }
+
+}
+
+void LovyanGFX::clear(uint32_t const color) {
+
+    fillRect(0, 0, _width, _height, color);
+
+}
+
+void LovyanGFX::drawBitmap(int32_t const x, int32_t const y, uint8_t const *bitmap, int32_t const w, int32_t const h, uint32_t const color) {
+
+    int32_t const stride = (w + 7) >> 3;
+
+    for (int32_t j = 0; j < h; ++j) {
+        for (int32_t i = 0; i < w; ++i) {
+            if (pgm_read_byte(bitmap + j * stride + (i >> 3)) & (0x80 >> (i & 7))) drawPixel(x + i, y + j, color);
+        }
+    }
+
+}
+
+void LovyanGFX::pushImage(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const *data, uint16_t const transp) {
+
+    for (int32_t j = 0; j < h; ++j) {
+        for (int32_t i = 0; i < w; ++i) {
+            uint16_t c = pgm_read_word(data + j * w + i);
+            if (c != transp) drawPixel(x + i, y + j, swap565(c));
+        }
+    }
+
+}
+
+void LovyanGFX::pushImage(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const *data) {
+
+    for (int32_t j = 0; j < h; ++j) {
+        for (int32_t i = 0; i < w; ++i) drawPixel(x + i, y + j, swap565(pgm_read_word(data + j * w + i)));
+    }
+
+}
+
+int32_t LovyanGFX::drawString(char const *string, int32_t const x, int32_t const y) {
+
+    int32_t n = strlen(string);
+    int32_t w = 6 * n;
+    int32_t h = 8;
+
+    int32_t left = x - ((_text_datum & 3) * w >> 1);
+    int32_t top  = y - ((_text_datum >> 2) * h >> 1);
+
+    for (int32_t k = 0; k < n; ++k) {
+        if (string[k] != ' ') fillRect(left + 6 * k, top, 5, 7, _text_color);
+    }
+
+    return w;
+
+}
+
+int32_t LovyanGFX::drawString(__FlashStringHelper const *string, int32_t const x, int32_t const y) {
+
+    return drawString(reinterpret_cast<char const *>(string), x, y);
+
+}
+
+int32_t LovyanGFX::drawNumber(long const n, int32_t const x, int32_t const y) {
+
+    char buffer[12];
+    snprintf(buffer, sizeof(buffer), "%ld", n);
+
+    return drawString(buffer, x, y);
+
+}
+
+// -----------------------------------------------------------------------------
+// Display panel
+// -----------------------------------------------------------------------------
+
+void LGFX::_writePixel(int32_t const x, int32_t const y, uint32_t const color) {
+
+    frame[y * _width + x] = color;
+    pixels++;
+
+}
+
+// -----------------------------------------------------------------------------
+// Sprites
+// -----------------------------------------------------------------------------
+
+void *LGFX_Sprite::createSprite(int32_t const w, int32_t const h) {
+
+    deleteSprite();
+
+    _buffer = new uint8_t[w * h * (_depth >> 3)]();
+    _resetClip(w, h);
+
+    return _buffer;
+
+}
+
+void LGFX_Sprite::deleteSprite() {
+
+    delete[] _buffer;
+    delete[] _palette;
+
+    _buffer  = nullptr;
+    _palette = nullptr;
+
+    _resetClip(0, 0);
+
+}
+
+void LGFX_Sprite::setColorDepth(uint8_t const bits) {
+
+    _depth = bits == 8 ? 8 : 16;
+
+    if (_buffer != nullptr) createSprite(_width, _height);
+
+}
+
+bool LGFX_Sprite::createPalette() {
+
+    if (_depth != 8) return false;
+
+    delete[] _palette;
+    _palette = new uint32_t[256];
+
+    for (uint16_t i = 0; i < 256; ++i) {
+        uint8_t r = (i >> 5) * 0x24;
+        uint8_t g = ((i >> 2) & 7) * 0x24;
+        uint8_t b = (i & 3) * 0x55;
+        _palette[i] = (r << 16) | (g << 8) | b;
+    }
+
+    return true;
+
+}
+
+void LGFX_Sprite::setPaletteColor(size_t const index, uint8_t const r, uint8_t const g, uint8_t const b) {
+
+    if (_palette != nullptr && index < 256) _palette[index] = (r << 16) | (g << 8) | b;
+
+}
+
+uint32_t LGFX_Sprite::readPixel(int32_t const x, int32_t const y) const {
+
+    if (x < 0 || x >= _width || y < 0 || y >= _height) return 0;
+
+    return _depth == 8
+        ? _buffer[y * _width + x]
+        : reinterpret_cast<uint16_t const *>(_buffer)[y * _width + x];
+
+}
+
+void LGFX_Sprite::_writePixel(int32_t const x, int32_t const y, uint32_t const color) {
+
+    if (_depth == 8) _buffer[y * _width + x] = color;
+    else reinterpret_cast<uint16_t *>(_buffer)[y * _width + x] = swap565(color);
+
+}
+
+void LGFX_Sprite::pushSprite(int32_t const x, int32_t const y) {
+
+    if (_parent != nullptr) _push(_parent, x, y);
+
+}
+
+void LGFX_Sprite::pushSprite(LovyanGFX * const dst, int32_t const x, int32_t const y) {
+
+    _push(dst, x, y);
+
+}
+
+void LGFX_Sprite::_push(LovyanGFX * const dst, int32_t const x, int32_t const y) {
+
+    LGFX_Sprite *sprite = dynamic_cast<LGFX_Sprite *>(dst);
+    bool indexed        = sprite != nullptr && sprite->_depth == 8 && _depth == 8;
+
+    for (int32_t j = 0; j < _height; ++j) {
+        for (int32_t i = 0; i < _width; ++i) {
+            uint32_t c = readPixel(i, j);
+            if (_depth == 16) c = swap565(c);
+            else if (!indexed) c = _palette != nullptr ? rgb565(_palette[c]) : c;
+            dst->drawPixel(x + i, y + j, c);
+        }
+    }
+
+}
+
+void LGFX_Sprite::pushRotateZoom(float const x, float const y, float const angle, float const zoom_x, float const zoom_y) {
+
+    if (_parent != nullptr) pushRotateZoom(_parent, x, y, angle, zoom_x, zoom_y);
+
+}
+
+void LGFX_Sprite::pushRotateZoom(LovyanGFX * const dst, float const x, float const y, float const angle, float const zoom_x, float const zoom_y) {
+
+    pushRotateZoom(dst, x, y, angle, zoom_x, zoom_y, _OPAQUE);
+
+}
+
+void LGFX_Sprite::pushRotateZoom(float const x, float const y, float const angle, float const zoom_x, float const zoom_y, uint32_t const transp) {
+
+    if (_parent != nullptr) pushRotateZoom(_parent, x, y, angle, zoom_x, zoom_y, transp);
+
+}
+
+void LGFX_Sprite::pushRotateZoom(LovyanGFX * const dst, float const x, float const y, float const angle, float const zoom_x, float const zoom_y, uint32_t const transp) {
+
+    // Rotation is not mirrored since the game only ever zooms.
+    (void)angle;
+
+    LGFX_Sprite *sprite = dynamic_cast<LGFX_Sprite *>(dst);
+    bool indexed        = sprite != nullptr && sprite->_depth == 8 && _depth == 8;
+
+    int32_t w  = ceilf(_width  * zoom_x);
+    int32_t h  = ceilf(_height * zoom_y);
+    int32_t x0 = floorf(x - w * .5f);
+    int32_t y0 = floorf(y - h * .5f);
+
+    for (int32_t j = y0; j < y0 + h + 1; ++j) {
+        int32_t sy = floorf((j + .5f - y) / zoom_y + _height * .5f);
+        if (sy < 0 || sy >= _height) continue;
+        for (int32_t i = x0; i < x0 + w + 1; ++i) {
+            int32_t sx = floorf((i + .5f - x) / zoom_x + _width * .5f);
+            if (sx < 0 || sx >= _width) continue;
+            uint32_t c = readPixel(sx, sy);
+            if (c == transp) continue;
+            if (_depth == 16) c = swap565(c);
+            else if (!indexed) c = _palette != nullptr ? rgb565(_palette[c]) : c;
+            dst->drawPixel(i, j, c);
+        }
+    }
+
+}
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,165 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   LovyanGFX.hpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Host stand-in for the subset of LovyanGFX used by the game
+ *
+ * @note Drawing primitives really write into the sprite buffers, so that the
+ *       rendering cost stays meaningful on the host. Text is approximated by
+ *       filled 5x7 cells laid out like the default 6x8 font.
+ *
+ *       Byte order follows LovyanGFX: colour arguments are plain RGB565,
+ *       whereas `uint16_t` images are read as byte-swapped RGB565, which is
+ *       also how 16-bit sprites store their pixels. The panel frame holds
+ *       the plain RGB565 colours actually shown, so that an image sent in
+ *       the wrong byte order shows up in it.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+
+enum textdatum_t : uint8_t {
+    TL_DATUM = 0,
+    TC_DATUM = 1,
+    TR_DATUM = 2,
+    ML_DATUM = 4,
+    MC_DATUM = 5,
+    MR_DATUM = 6,
+    BL_DATUM = 8,
+    BC_DATUM = 9,
+    BR_DATUM = 10,
+    CL_DATUM = ML_DATUM,
+    CC_DATUM = MC_DATUM,
+    CR_DATUM = MR_DATUM
+};
+
+class LovyanGFX {
+
+    public:
+
+        virtual ~LovyanGFX() = default;
+
+        int32_t width()  const { return _width;  }
+        int32_t height() const { return _height; }
+
+        void setClipRect(int32_t x, int32_t y, int32_t w, int32_t h);
+        void getClipRect(int32_t *x, int32_t *y, int32_t *w, int32_t *h) const;
+        void clearClipRect();
+
+        void clear(uint32_t const color = 0);
+        void fillScreen(uint32_t const color) { clear(color); }
+        void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t const color);
+        void drawPixel(int32_t const x, int32_t const y, uint32_t const color);
+
+        void drawBitmap(int32_t const x, int32_t const y, uint8_t const *bitmap, int32_t const w, int32_t const h, uint32_t const color);
+        void pushImage(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const *data, uint16_t const transp);
+        void pushImage(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const *data);
+
+        void setTextColor(uint32_t const color) { _text_color = color; }
+        void setTextDatum(uint8_t const datum)  { _text_datum = datum; }
+
+        int32_t drawString(char const *string, int32_t const x, int32_t const y);
+        int32_t drawString(__FlashStringHelper const *string, int32_t const x, int32_t const y);
+        int32_t drawNumber(long const n, int32_t const x, int32_t const y);
+
+    protected:
+
+        int32_t  _width      = 0;
+        int32_t  _height     = 0;
+        int32_t  _clip_l     = 0;
+        int32_t  _clip_t     = 0;
+        int32_t  _clip_r     = -1;
+        int32_t  _clip_b     = -1;
+        uint32_t _text_color = 0xffff;
+        uint8_t  _text_datum = TL_DATUM;
+
+        void _resetClip(int32_t const w, int32_t const h);
+
+        virtual void _writePixel(int32_t const x, int32_t const y, uint32_t const color) = 0;
+
+};
+
+class LGFX : public LovyanGFX {
+
+    public:
+
+        LGFX(int32_t const w, int32_t const h) : frame(w * h, 0) { _resetClip(w, h); }
+
+        std::vector<uint16_t> frame;
+
+        uint64_t pixels = 0;
+
+    protected:
+
+        void _writePixel(int32_t const x, int32_t const y, uint32_t const color) override;
+
+        friend class LGFX_Sprite;
+
+};
+
+class LGFX_Sprite : public LovyanGFX {
+
+    public:
+
+        LGFX_Sprite(LovyanGFX * const parent = nullptr) : _parent(parent) {}
+        ~LGFX_Sprite() { deleteSprite(); }
+
+        void *createSprite(int32_t const w, int32_t const h);
+        void  deleteSprite();
+        void  setColorDepth(uint8_t const bits);
+        bool  createPalette();
+        void  setPaletteColor(size_t const index, uint8_t const r, uint8_t const g, uint8_t const b);
+
+        void    *getBuffer()              { return _buffer; }
+        uint8_t  getColorDepth()    const { return _depth;  }
+        uint32_t readPixel(int32_t const x, int32_t const y) const;
+
+        void pushSprite(int32_t const x, int32_t const y);
+        void pushSprite(LovyanGFX * const dst, int32_t const x, int32_t const y);
+
+        void pushRotateZoom(float const x, float const y, float const angle, float const zoom_x, float const zoom_y);
+        void pushRotateZoom(LovyanGFX * const dst, float const x, float const y, float const angle, float const zoom_x, float const zoom_y);
+        void pushRotateZoom(float const x, float const y, float const angle, float const zoom_x, float const zoom_y, uint32_t const transp);
+        void pushRotateZoom(LovyanGFX * const dst, float const x, float const y, float const angle, float const zoom_x, float const zoom_y, uint32_t const transp);
+
+    protected:
+
+        void _writePixel(int32_t const x, int32_t const y, uint32_t const color) override;
+
+    private:
+
+        static uint32_t constexpr _OPAQUE = ~0U;
+
+        LovyanGFX *_parent;
+        uint8_t   *_buffer  = nullptr;
+        uint32_t  *_palette = nullptr;
+        uint8_t    _depth   = 16;
+
+        void _push(LovyanGFX * const dst, int32_t const x, int32_t const y);
+
+};
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
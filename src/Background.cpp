@@ -0,0 +1,127 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Background.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Retained image of the empty board
+ * -----------------------------------------------------------------------------
+ */
+
+#include "Background.h"
+
+uint32_t Background::_hash(uint8_t const *row) {
+
+    uint32_t h = 0x811c9dc5;
+    for (uint8_t x = 0; x < TFT_WIDTH; ++x) h = (h ^ row[x]) * 0x01000193;
+
+    return h;
+
+}
+
+uint8_t Background::_tally(LGFX_Sprite * const fb, int16_t const rows, uint32_t * const hashes, uint8_t count) const {
+
+    uint8_t const *band = (uint8_t const*)fb->getBuffer();
+
+    for (int16_t y = 0; y < rows; ++y) {
+
+        uint32_t h = _hash(band + y * fb->width());
+        uint8_t  k = 0;
+
+        while (k < count && hashes[k] != h) k++;
+        if (k == count) hashes[count++] = h;
+
+    }
+
+    return count;
+
+}
+
+bool Background::_reserve(uint8_t const count) {
+
+    _rows = (uint8_t*)malloc(count * TFT_WIDTH);
+    if (_rows == nullptr) return false;
+
+    _capacity = count;
+
+    return true;
+
+}
+
+bool Background::_capture(LGFX_Sprite * const fb, int16_t const oy, int16_t const rows) {
+
+    // The frame buffer holds the band of rows starting at `oy`, which the
+    // caller has just painted.
+    uint8_t const *band = (uint8_t const*)fb->getBuffer();
+
+    for (int16_t y = 0; y < rows; ++y) {
+
+        uint8_t const *row = band + y * fb->width();
+        uint8_t        k   = 0;
+
+        while (k < _count && memcmp(_rows + k * TFT_WIDTH, row, TFT_WIDTH) != 0) k++;
+
+        if (k == _count) {
+
+            // Two distinct rows sharing a hash leave no room for the last one.
+            if (k == _capacity) { release(); return false; }
+
+            memcpy(_rows + k * TFT_WIDTH, row, TFT_WIDTH);
+            _count++;
+
+        }
+
+        _row[oy + y] = k;
+
+    }
+
+    _ready = oy + rows >= TFT_HEIGHT;
+
+    return true;
+
+}
+
+bool Background::restore(LGFX_Sprite * const fb, Rect const &d, int16_t const oy) const {
+
+    if (!_ready) return false;
+
+    uint8_t *band = (uint8_t*)fb->getBuffer();
+
+    for (int16_t y = d.y; y < d.y + d.h; ++y) {
+        memcpy(band + (y - oy) * fb->width() + d.x, _rows + _row[y] * TFT_WIDTH + d.x, d.w);
+    }
+
+    return true;
+
+}
+
+void Background::release() {
+
+    free(_rows);
+
+    _rows     = nullptr;
+    _capacity = 0;
+    _count    = 0;
+    _ready    = false;
+
+}
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,110 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Background.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Retained image of the empty board
+ *
+ * @note The empty grid never changes during a game, yet every frame had to
+ *       repaint it from the tile spans before drawing the tiles on top. It is
+ *       now painted once, when the game frame buffer is set up, and each of
+ *       its screen rows is kept as a reference to one of the few distinct
+ *       rows it is made of: the gaps between the cells are all alike, and so
+ *       are most rows that cross the cells. Restoring any area of the board
+ *       is then a plain copy of each of its rows.
+ *
+ *       The board is painted twice when the image is built: the distinct rows
+ *       are counted from their hashes first, so that they are then stored in
+ *       a single allocation rather than growing it row after row.
+ *
+ *       The whole 4x4 background takes a few hundred bytes instead of the 16
+ *       KB of a full 8-bit image. Should they not be available, the board is
+ *       painted from scratch on every frame as before.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <ESPboy.h>
+#include "Rect.h"
+
+class Background {
+
+    public:
+
+        ~Background() { release(); }
+
+        // Paints the board into the frame buffer through `paint(oy, rows)`,
+        // one band of `band` rows at a time.
+        template <typename Paint>
+        bool build(LGFX_Sprite * const fb, int16_t const band, Paint const &paint);
+
+        bool restore(LGFX_Sprite * const fb, Rect const &d, int16_t const oy) const;
+        void release();
+
+        bool     ready() const { return _ready; }
+        uint8_t  rows()  const { return _count; }
+        uint16_t bytes() const { return _count * TFT_WIDTH + sizeof(_row); }
+
+    private:
+
+        uint8_t  _row[TFT_HEIGHT]; // index of the distinct row each screen row is a copy of
+        uint8_t *_rows     = nullptr;
+        uint8_t  _capacity = 0;
+        uint8_t  _count    = 0;
+        bool     _ready    = false;
+
+        static uint32_t _hash(uint8_t const *row);
+
+        uint8_t _tally(LGFX_Sprite * const fb, int16_t const rows, uint32_t * const hashes, uint8_t count) const;
+        bool    _reserve(uint8_t const count);
+        bool    _capture(LGFX_Sprite * const fb, int16_t const oy, int16_t const rows);
+
+};
+
+template <typename Paint>
+bool Background::build(LGFX_Sprite * const fb, int16_t const band, Paint const &paint) {
+
+    release();
+
+    uint32_t hashes[TFT_HEIGHT];
+    uint8_t  count = 0;
+
+    for (int16_t oy = 0; oy < TFT_HEIGHT; oy += band) {
+        int16_t rows = min<int16_t>(band, TFT_HEIGHT - oy);
+        paint(oy, rows);
+        count = _tally(fb, rows, hashes, count);
+    }
+
+    if (!_reserve(count)) return false;
+
+    for (int16_t oy = 0; oy < TFT_HEIGHT; oy += band) {
+        int16_t rows = min<int16_t>(band, TFT_HEIGHT - oy);
+        paint(oy, rows);
+        if (!_capture(fb, oy, rows)) return false;
+    }
+
+    return true;
+
+}
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
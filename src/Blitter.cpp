@@ -0,0 +1,165 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Blitter.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Decoders for the compressed graphics assets
+ * -----------------------------------------------------------------------------
+ */
+
+#include "Blitter.h"
+
+uint8_t Blitter::_zoom = 0;
+uint8_t Blitter::_size = 0;
+uint8_t Blitter::_step[_ZOOM_SPAN];
+
+void Blitter::image(
+    LGFX_Sprite * const fb,
+    int16_t  const  x,
+    int16_t  const  y,
+    uint8_t  const  w,
+    uint8_t  const  h,
+    uint16_t const *palette,
+    uint8_t  const *runs,
+    uint16_t const  transp
+) {
+
+    uint16_t line[TFT_WIDTH];
+
+    // Runs flow from one row to the next, so the pending one is carried over.
+    uint8_t  left  = 0;
+    uint16_t color = transp;
+
+    for (uint8_t j = 0; j < h; ++j) {
+
+        for (uint8_t i = 0; i < w; ++i) {
+            if (left == 0) {
+                uint8_t r = pgm_read_byte(runs++);
+                left      = (r >> 4) + 1;
+                color     = pgm_read_word(palette + (r & 0xf));
+            }
+            line[i] = color;
+            left--;
+        }
+
+        int16_t row = y + j;
+        if (row >= 0 && row < fb->height()) fb->pushImage(x, row, w, 1, line, transp);
+
+    }
+
+}
+
+void Blitter::spans(LGFX_Sprite * const fb, int16_t const x, int16_t const y, uint8_t const *data, uint32_t const color) {
+
+    uint8_t top  = pgm_read_byte(data++);
+    uint8_t rows = pgm_read_byte(data++);
+
+    for (uint8_t j = 0; j < rows; ++j) {
+
+        uint8_t n = pgm_read_byte(data++);
+
+        for (uint8_t k = 0; k < n; ++k) {
+            uint8_t sx  = pgm_read_byte(data++);
+            uint8_t len = pgm_read_byte(data++);
+            fb->fillRect(x + sx, y + top + j, len, 1, color);
+        }
+
+    }
+
+}
+
+void Blitter::trimmed(LGFX_Sprite * const fb, int16_t const x, int16_t const y, uint8_t const w, uint8_t const *data, uint32_t const color) {
+
+    uint8_t top  = pgm_read_byte(data);
+    uint8_t rows = pgm_read_byte(data + 1);
+
+    fb->drawBitmap(x, y + top, data + 2, w, rows, color);
+
+}
+
+void Blitter::zoomed(LGFX_Sprite * const fb, LGFX_Sprite &tile, uint8_t const zoom, int16_t const cx, int16_t const cy, uint8_t const transp) {
+
+    int32_t cl, ct, cw, ch;
+    fb->getClipRect(&cl, &ct, &cw, &ch);
+
+    _zoomed((uint8_t*)fb->getBuffer(), fb->width(), cl, ct, cl + cw, ct + ch, tile, zoom, cx, cy, transp);
+
+}
+
+void Blitter::zoomed(uint8_t * const frame, uint8_t const side, LGFX_Sprite &tile, uint8_t const zoom, uint8_t const transp) {
+
+    _zoomed(frame, side, 0, 0, side, side, tile, zoom, side >> 1, side >> 1, transp);
+
+}
+
+void Blitter::_zoomed(uint8_t * const dst, int16_t const stride, int16_t const cl, int16_t const ct, int16_t const cr, int16_t const cb, LGFX_Sprite &tile, uint8_t const zoom, int16_t const cx, int16_t const cy, uint8_t const transp) {
+
+    uint8_t const size = tile.width();
+    uint8_t const span = (size * zoom + 99) / 100 + 1;
+    int16_t const x0   = cx - (span >> 1);
+    int16_t const y0   = cy - (span >> 1);
+
+    if (span > _ZOOM_SPAN) return;
+
+    // The destination pixel at offset d from the center samples the source
+    // at (d + 1/2) / zoom from its middle, which is exact in integers when
+    // scaled by 200 * zoom. Rows and columns share the same table.
+    if (zoom != _zoom || size != _size) {
+
+        _zoom = zoom;
+        _size = size;
+
+        for (uint8_t k = 0; k < span; ++k) {
+            int32_t n = (2 * (k - (span >> 1)) + 1) * 100 + size * zoom;
+            int32_t s = n / (zoom << 1);
+            _step[k]  = n < 0 || s >= size ? _OUTSIDE : s;
+        }
+
+    }
+
+    int16_t top    = max<int16_t>(y0, ct);
+    int16_t bottom = min<int16_t>(y0 + span, cb);
+    int16_t left   = max<int16_t>(x0, cl);
+    int16_t right  = min<int16_t>(x0 + span, cr);
+
+    uint8_t const *src = (uint8_t const*)tile.getBuffer();
+
+    for (int16_t y = top; y < bottom; ++y) {
+
+        uint8_t sy = _step[y - y0];
+        if (sy == _OUTSIDE) continue;
+
+        uint8_t const *from = src + sy * size;
+        uint8_t       *row  = dst + y * stride;
+
+        for (int16_t x = left; x < right; ++x) {
+            uint8_t sx = _step[x - x0];
+            if (sx == _OUTSIDE) continue;
+            uint8_t c = from[sx];
+            if (c != transp) row[x] = c;
+        }
+
+    }
+
+}
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,91 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Blitter.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Decoders for the compressed graphics assets
+ *
+ * @note The assets are generated by tools/assets.py, which describes their
+ *       layout. Each decoder reads its stream once, front to back, and writes
+ *       straight into the sprite, so that no intermediate image is needed
+ *       and the flash cache only ever sees sequential reads.
+ *
+ *       Zoomed tiles are scaled with integers only, the ESP8266 having no
+ *       FPU: the source index of every destination row and column is worked
+ *       out once per scale, then each pixel is a mere table lookup.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <ESPboy.h>
+
+class Blitter {
+
+    public:
+
+        // Palette-indexed run-length image (the splash logo), at most TFT_WIDTH wide.
+        static void image(
+            LGFX_Sprite * const fb,
+            int16_t  const  x,
+            int16_t  const  y,
+            uint8_t  const  w,
+            uint8_t  const  h,
+            uint16_t const *palette,
+            uint8_t  const *runs,
+            uint16_t const  transp
+        );
+
+        // Monochrome image made of horizontal spans (the tile).
+        static void spans(LGFX_Sprite * const fb, int16_t const x, int16_t const y, uint8_t const *data, uint32_t const color);
+
+        // Monochrome bitmap stripped of its blank rows (the power-of-two labels).
+        static void trimmed(LGFX_Sprite * const fb, int16_t const x, int16_t const y, uint8_t const w, uint8_t const *data, uint32_t const color);
+
+        // Square 8-bit sprite scaled by `zoom` percent around (cx,cy), nearest
+        // neighbour. The middle of the source lies on the corner (cx,cy), and
+        // each destination pixel samples the source pixel its center falls
+        // in, at exactly zoom / 100, a center on a source edge taking the
+        // pixel after it. This is the rule pushRotateZoom() follows too, but
+        // its rounded scale may resolve such ties the other way and move an
+        // edge by one pixel: that is harmless in frames shown for a tick or
+        // two, and the exact rule draws every scale the same on any target.
+        static void zoomed(LGFX_Sprite * const fb, LGFX_Sprite &tile, uint8_t const zoom, int16_t const cx, int16_t const cy, uint8_t const transp);
+
+        // Same, centered into a bare square 8-bit image `side` pixels wide.
+        static void zoomed(uint8_t * const frame, uint8_t const side, LGFX_Sprite &tile, uint8_t const zoom, uint8_t const transp);
+
+    private:
+
+        // Widest span a 27 px tile may be zoomed to, up to 255%.
+        static uint8_t constexpr _ZOOM_SPAN = 72;
+        static uint8_t constexpr _OUTSIDE   = 0xff;
+
+        static uint8_t _zoom;
+        static uint8_t _size;
+        static uint8_t _step[_ZOOM_SPAN];
+
+        static void _zoomed(uint8_t * const dst, int16_t const stride, int16_t const cl, int16_t const ct, int16_t const cr, int16_t const cb, LGFX_Sprite &tile, uint8_t const zoom, int16_t const cx, int16_t const cy, uint8_t const transp);
+
+};
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,390 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Board.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Packed board engine
+ * -----------------------------------------------------------------------------
+ */
+
+#include "Board.h"
+
+namespace {
+
+    struct RowTable { uint16_t row[0x10000]; };
+
+    constexpr uint16_t slideLeft(uint16_t const row) {
+
+        uint8_t out[4] = { 0 };
+        uint8_t n      = 0;
+        uint8_t last   = 0;
+
+        for (uint8_t k = 0; k < 4; ++k) {
+            uint8_t p = (row >> (k << 2)) & 0xf;
+            if (p == 0) continue;
+            if (p == last && p < Board<4>::MAX_POW2) {
+                out[n-1] = p + 1;
+                last     = 0;
+            } else {
+                out[n++] = p;
+                last     = p;
+            }
+        }
+
+        return out[0] | (out[1] << 4) | (out[2] << 8) | (out[3] << 12);
+
+    }
+
+    constexpr RowTable buildLeftTable() {
+
+        RowTable t = {};
+        for (uint32_t r = 0; r < 0x10000; ++r) t.row[r] = slideLeft(r);
+        return t;
+
+    }
+
+}
+
+// Sliding any row to the left, indexed by the row itself (128 KB of flash).
+static RowTable const constexpr LEFT PROGMEM = buildLeftTable();
+
+// Merging two tiles of exponent k into one of exponent k+1 earns 2^(k+1)
+// points, which is exactly the increase of the sum of (k-1)*2^k over the tiles:
+// the score gained by a move is therefore the variation of this potential.
+static uint32_t const constexpr POTENTIAL[] PROGMEM = {
+    0, 0, 4, 16, 48, 128, 320, 768, 1792, 4096, 9216, 20480, 45056, 98304, 212992, 458752
+};
+
+uint8_t Board<4>::freeCells() const {
+
+    uint64_t x = cells;
+    x |= x >> 2;
+    x |= x >> 1;
+
+    return __builtin_popcountll(~x & 0x1111111111111111ULL);
+
+}
+
+uint16_t Board<4>::occupancy() const {
+
+    // Folds each nibble onto its lowest bit, then packs the 16 flags together.
+    uint64_t x = cells;
+    x |= x >> 2;
+    x |= x >> 1;
+    x &= 0x1111111111111111ULL;
+    x  = (x | x >> 3)  & 0x0303030303030303ULL;
+    x  = (x | x >> 6)  & 0x000f000f000f000fULL;
+    x  = (x | x >> 12) & 0x000000ff000000ffULL;
+    x  = (x | x >> 24);
+
+    return x;
+
+}
+
+uint8_t Board<4>::highest() const {
+
+    uint8_t top = 0;
+    for (uint64_t b = cells; b; b >>= 4) top = max<uint8_t>(top, b & 0xf);
+
+    return top;
+
+}
+
+uint8_t Board<4>::spawn(Prng &rng) {
+
+    // The rules of the game: any free cell is equally likely to receive the
+    // new tile, which is a 4 once in ten. Two draws, whatever the board.
+    uint16_t free = ~occupancy();
+    uint8_t  rank = select(free, rng.below(__builtin_popcount(free)));
+
+    set(rank >> 2, rank & 3, rng.below(10) == 0 ? 2 : 1);
+
+    return rank;
+
+}
+
+uint8_t Board<4>::select(uint16_t mask, uint8_t k) {
+
+    // Rank of the k-th set bit, found by halving the word four times.
+    uint8_t rank = 0;
+
+    for (uint8_t w = 8; w; w >>= 1) {
+        uint8_t n = __builtin_popcount(mask & ((1 << w) - 1));
+        if (k >= n) {
+            k    -= n;
+            mask >>= w;
+            rank += w;
+        }
+    }
+
+    return rank;
+
+}
+
+Board<4> Board<4>::move(Direction const d, uint32_t * const gain) const {
+
+    uint64_t b = cells;
+
+    switch (d) {
+        case Direction::LEFT:  b = _moveLeft(cells);                        break;
+        case Direction::RIGHT: b = _moveRight(cells);                       break;
+        case Direction::UP:    b = transpose(_moveLeft(transpose(cells)));  break;
+        case Direction::DOWN:  b = transpose(_moveRight(transpose(cells)));
+    }
+
+    if (gain != nullptr) *gain = b == cells ? 0 : _potential(b) - _potential(cells);
+
+    return Board(b);
+
+}
+
+uint8_t Board<4>::moves(Board * const next, uint32_t * const gain) const {
+
+    // All four successors at once, sharing a single transposition. Bit d of
+    // the returned mask is set when the direction d changes the board.
+    uint64_t t = transpose(cells);
+
+    next[static_cast<uint8_t>(Direction::LEFT)]  = _moveLeft(cells);
+    next[static_cast<uint8_t>(Direction::UP)]    = transpose(_moveLeft(t));
+    next[static_cast<uint8_t>(Direction::RIGHT)] = _moveRight(cells);
+    next[static_cast<uint8_t>(Direction::DOWN)]  = transpose(_moveRight(t));
+
+    uint32_t p    = gain != nullptr ? _potential(cells) : 0;
+    uint8_t  mask = 0;
+
+    for (uint8_t d = 0; d < 4; ++d) {
+        bool legal = next[d].cells != cells;
+        if (legal) mask |= 1 << d;
+        if (gain != nullptr) gain[d] = legal ? _potential(next[d].cells) - p : 0;
+    }
+
+    return mask;
+
+}
+
+uint64_t Board<4>::transpose(uint64_t const b) {
+
+    uint64_t a1 = b & 0xf0f00f0ff0f00f0fULL;
+    uint64_t a2 = b & 0x0000f0f00000f0f0ULL;
+    uint64_t a3 = b & 0x0f0f00000f0f0000ULL;
+    uint64_t a  = a1 | (a2 << 12) | (a3 >> 12);
+    uint64_t b1 = a & 0xff00ff0000ff00ffULL;
+    uint64_t b2 = a & 0x00ff00ff00000000ULL;
+    uint64_t b3 = a & 0x00000000ff00ff00ULL;
+
+    return b1 | (b2 >> 24) | (b3 << 24);
+
+}
+
+uint16_t Board<4>::_reverse(uint16_t const row) {
+
+    return (row >> 12) | ((row >> 4) & 0x00f0) | ((row << 4) & 0x0f00) | (row << 12);
+
+}
+
+uint16_t Board<4>::_left(uint16_t const row) {
+
+    return pgm_read_word(LEFT.row + row);
+
+}
+
+uint16_t Board<4>::_right(uint16_t const row) {
+
+    return _reverse(_left(_reverse(row)));
+
+}
+
+uint64_t Board<4>::_moveLeft(uint64_t const b) {
+
+    uint32_t lo = b;
+    uint32_t hi = b >> 32;
+
+    lo = _left(lo) | ((uint32_t)_left(lo >> 16) << 16);
+    hi = _left(hi) | ((uint32_t)_left(hi >> 16) << 16);
+
+    return ((uint64_t)hi << 32) | lo;
+
+}
+
+uint64_t Board<4>::_moveRight(uint64_t const b) {
+
+    uint32_t lo = b;
+    uint32_t hi = b >> 32;
+
+    lo = _right(lo) | ((uint32_t)_right(lo >> 16) << 16);
+    hi = _right(hi) | ((uint32_t)_right(hi >> 16) << 16);
+
+    return ((uint64_t)hi << 32) | lo;
+
+}
+
+uint32_t Board<4>::_potential(uint64_t const b) {
+
+    uint32_t p = 0;
+    for (uint8_t k = 0; k < 64; k += 4) p += pgm_read_dword(POTENTIAL + ((b >> k) & 0xf));
+
+    return p;
+
+}
+
+// -----------------------------------------------------------------------------
+// Other board sizes
+// -----------------------------------------------------------------------------
+
+template <uint8_t N>
+uint8_t Board<N>::freeCells() const {
+
+    uint8_t n = 0;
+    for (uint8_t k = 0; k < CELLS; ++k) n += cells[k] == 0;
+
+    return n;
+
+}
+
+template <uint8_t N>
+typename Board<N>::Mask Board<N>::occupancy() const {
+
+    Mask m = 0;
+    for (uint8_t k = 0; k < CELLS; ++k) if (cells[k]) m |= (Mask)1 << k;
+
+    return m;
+
+}
+
+template <uint8_t N>
+uint8_t Board<N>::highest() const {
+
+    uint8_t top = 0;
+    for (uint8_t k = 0; k < CELLS; ++k) top = max(top, cells[k]);
+
+    return top;
+
+}
+
+template <uint8_t N>
+uint8_t Board<N>::spawn(Prng &rng) {
+
+    Mask    full = CELLS == sizeof(Mask) * 8 ? (Mask)~0 : ((Mask)1 << CELLS) - 1;
+    Mask    free = ~occupancy() & full;
+    uint8_t rank = select(free, rng.below(__builtin_popcountll(free)));
+
+    cells[rank] = rng.below(10) == 0 ? 2 : 1;
+
+    return rank;
+
+}
+
+template <uint8_t N>
+Board<N> Board<N>::move(Direction const d, uint32_t * const gain) const {
+
+    Board    b;
+    uint8_t  line[N];
+    uint32_t g = 0;
+
+    for (uint8_t k = 0; k < N; ++k) {
+        for (uint8_t r = 0; r < N; ++r) line[r] = cells[_index(d, k, r)];
+        g += _slide(line);
+        for (uint8_t r = 0; r < N; ++r) b.cells[_index(d, k, r)] = line[r];
+    }
+
+    if (gain != nullptr) *gain = g;
+
+    return b;
+
+}
+
+template <uint8_t N>
+uint8_t Board<N>::moves(Board * const next, uint32_t * const gain) const {
+
+    uint8_t mask = 0;
+
+    for (uint8_t d = 0; d < 4; ++d) {
+        next[d] = move(static_cast<Direction>(d), gain != nullptr ? gain + d : nullptr);
+        if (next[d] != *this) mask |= 1 << d;
+    }
+
+    return mask;
+
+}
+
+template <uint8_t N>
+uint8_t Board<N>::select(Mask mask, uint8_t k) {
+
+    uint8_t rank = 0;
+
+    for (uint8_t w = sizeof(Mask) << 2; w; w >>= 1) {
+        uint8_t n = __builtin_popcountll(mask & (((Mask)1 << w) - 1));
+        if (k >= n) {
+            k    -= n;
+            mask >>= w;
+            rank += w;
+        }
+    }
+
+    return rank;
+
+}
+
+template <uint8_t N>
+uint8_t Board<N>::_index(Direction const d, uint8_t const k, uint8_t const r) {
+
+    switch (d) {
+        case Direction::LEFT:  return k * N + r;
+        case Direction::UP:    return r * N + k;
+        case Direction::RIGHT: return k * N + N - 1 - r;
+        default:               return (N - 1 - r) * N + k;
+    }
+
+}
+
+template <uint8_t N>
+uint32_t Board<N>::_slide(uint8_t * const line) {
+
+    // Same rule as the 4x4 table, the line being compacted in place.
+    uint32_t gain = 0;
+    uint8_t  n    = 0;
+    uint8_t  last = 0;
+
+    for (uint8_t k = 0; k < N; ++k) {
+        uint8_t p = line[k];
+        if (p == 0) continue;
+        if (p == last && p < MAX_POW2) {
+            line[n-1] = p + 1;
+            gain     += 1UL << (p + 1);
+            last      = 0;
+        } else {
+            line[n++] = p;
+            last      = p;
+        }
+    }
+
+    while (n < N) line[n++] = 0;
+
+    return gain;
+
+}
+
+#if BOARD_SIZE != 4
+template class Board<BOARD_SIZE>;
+#endif
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
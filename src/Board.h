@@ -0,0 +1,151 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Board.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Packed board engine
+ *
+ * @note The whole 4x4 grid fits into a single 64-bit word: each cell holds the
+ *       exponent of its tile on 4 bits (0 stands for an empty cell), and the
+ *       cell (i,j) lives in the nibble of rank 4i+j. Rows are moved to the
+ *       left through a precomputed lookup table stored in flash, the other
+ *       directions being obtained by reversing and/or transposing the word.
+ *
+ *       As a consequence, the highest tile the engine can handle is 32768,
+ *       a limit the other board sizes abide by as well. They are only ever
+ *       instantiated for the size the firmware is built for.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <type_traits>
+#include "Prng.h"
+
+#ifndef BOARD_SIZE
+#define BOARD_SIZE 4
+#endif
+
+enum class Direction : uint8_t {
+    LEFT,
+    UP,
+    RIGHT,
+    DOWN
+};
+
+// Any board from 3x3 to 8x8, with one byte per cell. The usual 4x4 board is
+// specialized below into the packed engine.
+template <uint8_t N>
+class Board {
+
+    static_assert(N >= 3 && N <= 8, "the board size must range from 3 to 8");
+
+    public:
+
+        typedef typename std::conditional<(N * N <= 16), uint16_t,
+                typename std::conditional<(N * N <= 32), uint32_t, uint64_t>::type>::type Mask;
+
+        static uint8_t constexpr SIZE     = N;
+        static uint8_t constexpr CELLS    = N * N;
+        static uint8_t constexpr MAX_POW2 = 15;
+
+        uint8_t cells[CELLS];
+
+        Board() : cells() {}
+
+        bool operator==(Board const &b) const { return memcmp(cells, b.cells, CELLS) == 0; }
+        bool operator!=(Board const &b) const { return !(*this == b); }
+
+        uint8_t get(uint8_t const i, uint8_t const j) const { return cells[i * N + j]; }
+
+        void set(uint8_t const i, uint8_t const j, uint8_t const pow2) { cells[i * N + j] = pow2; }
+
+        uint8_t freeCells() const;
+        Mask    occupancy() const;
+        uint8_t highest()   const;
+
+        uint8_t spawn(Prng &rng);
+
+        Board   move(Direction const d, uint32_t * const gain = nullptr) const;
+        uint8_t moves(Board * const next, uint32_t * const gain = nullptr) const;
+
+        static uint8_t select(Mask mask, uint8_t k);
+
+    private:
+
+        static uint8_t  _index(Direction const d, uint8_t const k, uint8_t const r);
+        static uint32_t _slide(uint8_t * const line);
+
+};
+
+template <>
+class Board<4> {
+
+    public:
+
+        typedef uint16_t Mask;
+
+        static uint8_t constexpr SIZE     = 4;
+        static uint8_t constexpr CELLS    = 16;
+        static uint8_t constexpr MAX_POW2 = 15;
+
+        uint64_t cells;
+
+        Board(uint64_t const cells = 0) : cells(cells) {}
+
+        bool operator==(Board const &b) const { return cells == b.cells; }
+        bool operator!=(Board const &b) const { return cells != b.cells; }
+
+        uint8_t get(uint8_t const i, uint8_t const j) const {
+            return (cells >> ((i << 4) | (j << 2))) & 0xf;
+        }
+
+        void set(uint8_t const i, uint8_t const j, uint8_t const pow2) {
+            uint8_t const s = (i << 4) | (j << 2);
+            cells = (cells & ~(0xfULL << s)) | ((uint64_t)pow2 << s);
+        }
+
+        uint8_t  freeCells() const;
+        uint16_t occupancy() const;
+        uint8_t  highest()   const;
+
+        uint8_t spawn(Prng &rng);
+
+        Board   move(Direction const d, uint32_t * const gain = nullptr) const;
+        uint8_t moves(Board * const next, uint32_t * const gain = nullptr) const;
+
+        static uint64_t transpose(uint64_t const b);
+        static uint8_t  select(uint16_t mask, uint8_t k);
+
+    private:
+
+        static uint16_t _reverse(uint16_t const row);
+        static uint16_t _left(uint16_t const row);
+        static uint16_t _right(uint16_t const row);
+        static uint64_t _moveLeft(uint64_t const b);
+        static uint64_t _moveRight(uint64_t const b);
+        static uint32_t _potential(uint64_t const b);
+
+};
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,113 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Delta.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Events of a single turn
+ * -----------------------------------------------------------------------------
+ */
+
+#include "Delta.h"
+
+template <uint8_t N>
+Board<N> Delta<N>::move(Board<N> const &b, Direction const d) {
+
+    uint32_t g;
+    Board<N> next = b.move(d, &g);
+
+    record(b, d, next, g);
+
+    return next;
+
+}
+
+template <uint8_t N>
+void Delta<N>::record(Board<N> const &b, Direction const d, Board<N> const &next, uint32_t const gain) {
+
+    clear();
+    this->gain = gain;
+
+    for (uint8_t k = 0; k < N; ++k) {
+
+        uint8_t cell[N];
+        uint8_t pow2[N];
+        uint8_t n = 0;
+
+        for (uint8_t r = 0; r < N; ++r) {
+            uint8_t c = _index(d, k, r);
+            uint8_t p = b.get(c / N, c % N);
+            if (p != 0) { cell[n] = c; pow2[n] = p; n++; }
+        }
+
+        // The tiles keep their order along the line: when the cell a tile
+        // lands on ends up with another value, the next tile merges into it.
+        for (uint8_t r = 0, s = 0; s < n; ++r, ++s) {
+
+            uint8_t to = _index(d, k, r);
+            uint8_t p  = next.get(to / N, to % N);
+
+            if (cell[s] != to) _push(Event::SLIDE, cell[s], to, pow2[s]);
+            if (p != pow2[s])  _push(Event::MERGE, cell[++s], to, p);
+
+        }
+
+    }
+
+}
+
+template <uint8_t N>
+void Delta<N>::spawned(uint8_t const cell, uint8_t const pow2) {
+
+    _push(Event::SPAWN, cell, cell, pow2);
+
+}
+
+template <uint8_t N>
+void Delta<N>::_push(typename Event::Kind const kind, uint8_t const from, uint8_t const to, uint8_t const pow2) {
+
+    if (_size == CAPACITY) return;
+
+    Event &e = _events[_size++];
+
+    e.kind = kind;
+    e.from = from;
+    e.to   = to;
+    e.pow2 = pow2;
+
+}
+
+template <uint8_t N>
+uint8_t Delta<N>::_index(Direction const d, uint8_t const k, uint8_t const r) {
+
+    // Rank r of the line k, counted from the edge the tiles are pushed to.
+    switch (d) {
+        case Direction::LEFT:  return k * N + r;
+        case Direction::UP:    return r * N + k;
+        case Direction::RIGHT: return k * N + N - 1 - r;
+        default:               return (N - 1 - r) * N + k;
+    }
+
+}
+
+template class Delta<BOARD_SIZE>;
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
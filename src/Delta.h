@@ -0,0 +1,93 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Delta.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Events of a single turn
+ *
+ * @note The board engine only deals with tile values, and knows nothing about
+ *       where the tiles come from. A delta tells what a move did to them, as a
+ *       short list of events: each tile that slides or gets absorbed by
+ *       another, then the tile spawned at the end of the turn. The renderer
+ *       builds its animations out of these events only, so that its work is
+ *       proportional to what actually changed on the board.
+ *
+ *       A delta is a plain value of fixed size, which is refilled on each
+ *       move without any allocation.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "Board.h"
+
+template <uint8_t N>
+class Delta {
+
+    public:
+
+        // Every tile yields one event at most, and a move that changes a full
+        // board merges two of them at least, which leaves room for the spawn.
+        static uint8_t constexpr CAPACITY = N * N + 1;
+
+        struct Event {
+
+            enum Kind : uint8_t {
+                SLIDE, // the tile moves from one cell to another
+                MERGE, // the tile moves onto the cell of the one it merges into
+                SPAWN  // a new tile shows up in the `to` cell
+            };
+
+            Kind    kind;
+            uint8_t from; // cell index i*N+j
+            uint8_t to;
+            uint8_t pow2; // exponent of the tile left on `to` after the event
+
+        };
+
+        uint32_t gain = 0;
+
+        void clear() { _size = 0; gain = 0; }
+
+        Board<N> move(Board<N> const &b, Direction const d);
+        void     record(Board<N> const &b, Direction const d, Board<N> const &next, uint32_t const gain);
+        void     spawned(uint8_t const cell, uint8_t const pow2);
+
+        uint8_t size() const { return _size; }
+
+        Event const &operator[](uint8_t const k) const { return _events[k]; }
+        Event const *begin() const { return _events; }
+        Event const *end()   const { return _events + _size; }
+
+    private:
+
+        Event   _events[CAPACITY];
+        uint8_t _size = 0;
+
+        void _push(typename Event::Kind const kind, uint8_t const from, uint8_t const to, uint8_t const pow2);
+
+        static uint8_t _index(Direction const d, uint8_t const k, uint8_t const r);
+
+};
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
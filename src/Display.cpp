@@ -0,0 +1,39 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Display.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Display backends
+ * -----------------------------------------------------------------------------
+ */
+
+#include "Display.h"
+
+void TftDisplay::push(LGFX_Sprite * const fb, Rect const &r, int16_t const oy) {
+
+    espboy.tft.setClipRect(r.x, r.y, r.w, r.h);
+    fb->pushSprite(0, oy);
+    espboy.tft.clearClipRect();
+
+}
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
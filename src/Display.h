@@ -0,0 +1,63 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Display.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Display backends
+ *
+ * @note The frame buffer reaches the screen through a display backend, which
+ *       sends the area that was redrawn and returns once it is on the panel.
+ *       LovyanGFX has no SPI DMA for the ESP8266, so there is nothing the
+ *       transfer could overlap with on the ESPboy, and the frame buffer is
+ *       pushed as is, the driver converting its palette indices on the way.
+ *
+ *       The seam lets the host harness stand in a backend of its own, which
+ *       accounts for the time a real bus would take.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <ESPboy.h>
+#include "Rect.h"
+
+class Display {
+
+    public:
+
+        virtual ~Display() {}
+
+        // Sends the screen area `r` out of the frame buffer, which holds the
+        // band of screen rows starting at `oy`.
+        virtual void push(LGFX_Sprite * const fb, Rect const &r, int16_t const oy) = 0;
+
+};
+
+class TftDisplay : public Display {
+
+    public:
+
+        void push(LGFX_Sprite * const fb, Rect const &r, int16_t const oy) override;
+
+};
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -8,39 +8,70 @@
 
 #include "Game.h"
 #include "assets.h"
+#include "Blitter.h"
 #include <ESP_EEPROM.h>
 
-void Game::begin() {
+template <uint8_t N>
+void Game<N>::begin() {
 
     espboy.begin();
 
-    _loadHighScore();
+#ifdef PROFILE
+    Serial.begin(115200);
+#endif
+
+    _load();
 
     _fb = new LGFX_Sprite(&espboy.tft);
 
-    _initSplashFrameBuffer();
+    memset(_board, Tiles::NONE, sizeof(_board));
+
+    _hinting = false;
+    _hinted  = -1;
+    _games   = 0;
+
+    if (_restore()) {
+
+        // A game interrupted by a reset goes on at once, without any splash.
+        _initPlayFrameBuffer();
+
+        _state = State::RESUME;
+
+    } else {
+
+        _initSplashFrameBuffer();
+
+        for (uint8_t i = 0; i < 4; ++i) _splash_tiles_y[i] = 128;
 
-    for (uint8_t i = 0; i < 4; ++i) _splash_tiles_y[i] = 128;
+        _splash_step = 0;
+        _last        = millis();
+        _state       = State::SPLASH;
+
+    }
 
-    _splash_step = 0;
-    _last        = millis();
-    _state       = State::SPLASH;
+    _ticker.begin(_TICK_PERIOD);
 
 }
 
-void Game::_initSplashFrameBuffer() {
+template <uint8_t N>
+void Game<N>::_initSplashFrameBuffer() {
 
-    _fb->createSprite(TFT_WIDTH, TFT_HEIGHT);
+    _fb->createSprite(TFT_WIDTH, RENDER_BAND_ROWS);
     _fb->setColorDepth(16);
 
 }
 
-void Game::_initPlayFrameBuffer() {
+template <uint8_t N>
+void Game<N>::_initPlayFrameBuffer() {
 
-    _fb->createSprite(TFT_WIDTH, TFT_HEIGHT);
+    _fb->createSprite(TFT_WIDTH, RENDER_BAND_ROWS);
     _fb->setColorDepth(8);
     _fb->createPalette();
 
+    // The tile caches take their share of the heap only now, once the splash
+    // screen has given back its frame buffer.
+    Tiles::begin();
+
     uint16_t c;
     uint8_t  r, g, b;
     for (uint8_t i = 0; i < PALETTE_SIZE; ++i) {
@@ -59,42 +90,83 @@ void Game::_initPlayFrameBuffer() {
 
     }
 
+    // The empty board is painted once and for all, band by band.
+    _background.build(_fb, RENDER_BAND_ROWS, [this](int16_t const oy, int16_t const rows) {
+        _paintBackground(Rect(0, oy, TFT_WIDTH, rows), oy);
+    });
+
 }
 
-void Game::loop() {
+template <uint8_t N>
+void Game<N>::loop() {
 
-    espboy.update();
+#ifdef PROFILE
+    // Any byte received over the serial line asks for a report.
+    if (Serial.available()) {
+        while (Serial.available()) Serial.read();
+        profile();
+    }
+#endif
 
-    _update();
-    _draw();
+    PROFILE_SCOPE(FRAME);
+
+    // Presses are gathered on every loop, even when no tick is due.
+    {
+        PROFILE_SCOPE(INPUT);
+        espboy.update();
+        _input.poll();
+    }
+
+    // The game logic runs at a fixed rate whatever the rendering cost, and
+    // the frame rendered afterwards is interpolated between the last two ticks.
+    uint8_t ticks = _ticker.due();
+
+    for (uint8_t k = 0; k < ticks; ++k) _tick();
+
+    _draw(ticks > 0);
+
+    _think();
 
 }
 
-void Game::_update() {
+template <uint8_t N>
+void Game<N>::_tick() {
+
+    { PROFILE_SCOPE(ANIMATE); _tiles.snapshot(); }
+    { PROFILE_SCOPE(LOGIC);   _update();         }
+
+}
+
+template <uint8_t N>
+void Game<N>::_update() {
 
     switch (_state) {
 
-        case State::SPLASH:                 return;
+        case State::SPLASH:    _splash();   break;
         case State::LAUNCH:    _launch();   break;
+        case State::RESUME:    _resume();   break;
         case State::START:     _start();    break;
         case State::INIT:      _init();     break;
-        case State::SPAWN:     _spawn();    break;
-        case State::PLAY:      _play();     break;
-        case State::SLIDING:   _showMove(); break;
+        case State::SPAWN:     if (!_interrupt()) _spawn();    break;
+        case State::PLAY:      _play();                        break;
+        case State::SLIDING:   if (!_interrupt()) _showMove(); break;
         case State::LOST:      _lost();     break;
-        case State::GAME_OVER: _gameOver();
+        case State::GAME_OVER: _gameOver(); break;
+        case State::FADING:    _fading();
 
     }
 
 }
 
-void Game::_draw() {
+template <uint8_t N>
+void Game<N>::_draw(bool const ticked) {
 
     switch (_state) {
 
         case State::SPLASH:
-        case State::LAUNCH:    _drawSplash();   break;
-        case State::GAME_OVER: _drawGameOver(); break;
+        case State::LAUNCH:    if (ticked) _drawSplash();   break;
+        case State::GAME_OVER: if (ticked) _drawGameOver(); break;
+        case State::FADING:    break;
 
         default: _drawBoard();
 
@@ -102,17 +174,53 @@ void Game::_draw() {
 
 }
 
-void Game::_drawSplash() {
+template <uint8_t N>
+void Game<N>::_splash() {
+
+    // Nothing pressed before the game can be launched is taken into account.
+    _input.clear();
+
+    if (millis() - _last < 1000) return;
+
+    uint8_t top = 17 + M1CR0LAB_SIZE + 8 + 20;
+    uint8_t dy;
+
+    for (uint8_t i = 0; i < 4; ++i) {
+        if (_splash_step == i) {
+            dy = _splash_tiles_y[i] - top;
+            if (dy < 2) {
+                _splash_tiles_y[i] = top;
+                _splash_step++;
+            } else _splash_tiles_y[i] -= dy >> 1;
+        } else _state = State::LAUNCH;
+    }
+
+}
+
+template <uint8_t N>
+void Game<N>::_drawSplash() {
+
+    for (int16_t oy = 0; oy < TFT_HEIGHT; oy += RENDER_BAND_ROWS) {
+        { PROFILE_SCOPE(PAINT); _paintSplash(oy);       }
+        { PROFILE_SCOPE(PUSH);  _display->push(_fb, Rect(0, oy, TFT_WIDTH, min<int16_t>(RENDER_BAND_ROWS, TFT_HEIGHT - oy)), oy); }
+    }
+
+}
+
+template <uint8_t N>
+void Game<N>::_paintSplash(int16_t const oy) {
 
     _fb->clear();
 
-    uint8_t top = 17;
+    int16_t top = 17 - oy;
 
-    _fb->pushImage(
+    Blitter::image(
+        _fb,
         (TFT_WIDTH - M1CR0LAB_SIZE) >> 1,
         top,
         M1CR0LAB_SIZE,
         M1CR0LAB_SIZE,
+        M1CR0LAB_PALETTE,
         M1CR0LAB,
         M1CR0LAB_TRANS_COLOR
     );
@@ -130,75 +238,114 @@ void Game::_drawSplash() {
             uint8_t x = i * TILE_SIZE + ((i+1) << 2);
             uint8_t p = i == 0 ? 1 : (i == 1 ? 0 : i);
 
-            _fb->drawBitmap(
+            Blitter::spans(
+                _fb,
                 x,
-                y,
+                y - oy,
                 TILE,
-                TILE_SIZE,
-                TILE_SIZE,
                 pgm_read_word(PALETTE + p)
             );
 
             _fb->setTextColor(pgm_read_word(PALETTE + (p == 1 || p == 2 ? 19 : 20)));
-            _fb->drawNumber(p == 0 ? 0 : 1 << p, x + (TILE_SIZE >> 1), y + (TILE_SIZE >> 1));
+            _fb->drawNumber(p == 0 ? 0 : 1 << p, x + (TILE_SIZE >> 1), y - oy + (TILE_SIZE >> 1));
 
         }
     }
 
-    if (millis() - _last >= 1000) {
+}
+
+template <uint8_t N>
+void Game<N>::_drawBoard() {
+
+    uint16_t alpha = _ticker.alpha();
+
+    { PROFILE_SCOPE(ANIMATE); _tiles.invalidate(_dirty, alpha); }
+
+    // Only the areas touched by the animated tiles are recomposited and
+    // pushed to the display, which leaves the SPI bus idle most of the time.
+    DirtyRects dirty = _dirty;
+    _dirty.clear();
+
+    for (Rect d : dirty) {
+
+        if (d.x < 0) { d.w += d.x; d.x = 0; }
+        if (d.y < 0) { d.h += d.y; d.y = 0; }
+        if (d.x + d.w > TFT_WIDTH)  d.w = TFT_WIDTH  - d.x;
+        if (d.y + d.h > TFT_HEIGHT) d.h = TFT_HEIGHT - d.y;
 
-        top += 20;
+        if (d.empty()) continue;
 
-        uint8_t dy;
+        int16_t bottom = d.y + d.h;
+
+        for (int16_t oy = d.y - d.y % RENDER_BAND_ROWS; oy < bottom; oy += RENDER_BAND_ROWS) {
+
+            Rect b = d;
+            b.y    = max(d.y, oy);
+            b.h    = min<int16_t>(bottom, oy + RENDER_BAND_ROWS) - b.y;
+
+            { PROFILE_SCOPE(PAINT); _paintBoard(b, oy); }
+            { PROFILE_SCOPE(PUSH);  _display->push(_fb, b, oy); }
 
-        for (uint8_t i = 0; i < 4; ++i) {
-            if (_splash_step == i) {
-                dy = _splash_tiles_y[i] - top;
-                if (dy < 2) {
-                    _splash_tiles_y[i] = top;
-                    _splash_step++;
-                } else _splash_tiles_y[i] -= dy >> 1;
-            } else _state = State::LAUNCH;
         }
 
     }
 
-    _fb->pushSprite(0, 0);
-
 }
 
-void Game::_drawBoard() {
+template <uint8_t N>
+void Game<N>::_paintBoard(Rect const &d, int16_t const oy) {
 
-    _fb->clear(18);
+    _fb->setClipRect(d.x, d.y - oy, d.w, d.h);
 
-    for (uint8_t i = 0; i < 4; ++i) {
-        for (uint8_t j = 0; j < 4; ++j) {
-            _fb->drawBitmap(
-                j * TILE_SIZE + ((j+1) << 2),
-                i * TILE_SIZE + ((i+1) << 2),
-                TILE,
-                TILE_SIZE,
-                TILE_SIZE,
-                0
-            );
+    if (!_background.restore(_fb, d, oy)) _paintBackground(d, oy);
+
+    // The hint lies beneath the tiles, since zoomed ones may cover the gap.
+    if (_hinted >= 0) {
+        Rect bar = _hintBar(_hinted);
+        if (d.intersects(bar)) _fb->fillRect(bar.x, bar.y - oy, bar.w, bar.h, 20);
+    }
+
+    // Zoomed tiles overflow their cell, so they are drawn on top of the others.
+    Mask live = _tiles.live();
+    for (uint8_t pass = 0; pass < 2; ++pass) {
+        for (Handle t = 0; t < Tiles::CAPACITY; ++t) {
+            if (!(live & ((Mask)1 << t)) || _tiles.scaling(t) != (pass == 1)) continue;
+            if (d.intersects(_tiles.bounds(t))) _tiles.draw(_fb, t, oy);
         }
     }
 
-    Tile *t;
-    for (uint8_t i = 0; i < 4; ++i) {
-        for (uint8_t j = 0; j < 4; ++j) {
-            if ((t = _board[i][j]) != nullptr) t->draw(_fb);
+    _fb->clearClipRect();
+
+}
+
+template <uint8_t N>
+void Game<N>::_paintBackground(Rect const &d, int16_t const oy) {
+
+    _fb->fillRect(d.x, d.y - oy, d.w, d.h, 18);
+
+    for (uint8_t i = 0; i < N; ++i) {
+        for (uint8_t j = 0; j < N; ++j) {
+            if (d.intersects(Tiles::cell(i, j))) Tiles::drawCell(_fb, i, j, oy);
         }
     }
 
-    _fb->pushSprite(0, 0);
+}
+
+template <uint8_t N>
+void Game<N>::_drawGameOver() {
+
+    for (int16_t oy = 0; oy < TFT_HEIGHT; oy += RENDER_BAND_ROWS) {
+        { PROFILE_SCOPE(PAINT); _paintGameOver(oy); }
+        { PROFILE_SCOPE(PUSH);  _display->push(_fb, Rect(0, oy, TFT_WIDTH, min<int16_t>(RENDER_BAND_ROWS, TFT_HEIGHT - oy)), oy); }
+    }
 
 }
 
-void Game::_drawGameOver() {
+template <uint8_t N>
+void Game<N>::_paintGameOver(int16_t const oy) {
 
-    uint8_t x = TFT_WIDTH >> 1;
-    uint8_t y = 22;
+    int16_t x = TFT_WIDTH >> 1;
+    int16_t y = 22 - oy;
 
     _fb->clear(21);
 
@@ -208,7 +355,7 @@ void Game::_drawGameOver() {
     _fb->setTextColor(14);
     _fb->drawString(F("HIGH SCORE"), x, y + 64);
     _fb->setTextColor(12);
-    _fb->drawNumber(_backup_data.highscore, x + 4, y + 76);
+    _fb->drawNumber(_backup_data.highscore[N - 3], x + 4, y + 76);
 
     _fb->setTextDatum(TR_DATUM);
     _fb->setTextColor(9);
@@ -222,43 +369,76 @@ void Game::_drawGameOver() {
     _fb->drawNumber(_moves,       x + 4, y + 32);
     _fb->drawNumber(_score,       x + 4, y + 44);
 
-    _fb->pushSprite(0, 0);
-
 }
 
-void Game::_launch() {
+template <uint8_t N>
+void Game<N>::_launch() {
 
-    if (espboy.button.pressed(Button::ACT)) {
+    if (_pressed(Button::ACT)) {
+
+        // The time it takes the player to press the button seeds the game.
+        _rng.seed(_rng.next() ^ micros());
 
         _fb->deleteSprite();
         _initPlayFrameBuffer();
 
-        _phantom_count = 0;
-        _state         = State::START;
+        _dirty = Rect(0, 0, TFT_WIDTH, TFT_HEIGHT);
+        _state = State::START;
 
     }
 
 }
 
-void Game::_start() {
+template <uint8_t N>
+void Game<N>::_resume() {
 
-    for (uint8_t i = 0; i < 4; ++i) {
-        for (uint8_t j = 0; j < 4; ++j) {
-            _board[i][j] = nullptr;
+    Mask live    = _tiles.live();
+    bool arising = false;
+
+    for (Handle t = 0; t < Tiles::CAPACITY; ++t) {
+        if ((live & ((Mask)1 << t)) && _tiles.arising(t)) {
+            _tiles.arise(t);
+            arising = true;
         }
     }
 
-    _free_tiles = 16;
+    if (!arising) _state = State::PLAY;
+
+}
+
+template <uint8_t N>
+void Game<N>::_start() {
+
+    for (uint8_t i = 0; i < N; ++i) {
+        for (uint8_t j = 0; j < N; ++j) {
+            _board[i][j] = Tiles::NONE;
+        }
+    }
+
+    _tiles.clear();
+    _delta.clear();
+    _log.begin(_rng.state());
+    _history.clear();
+
+    _grid       = Board<N>();
+    _dirty      = Rect(0, 0, TFT_WIDTH, TFT_HEIGHT);
+    _free_tiles = N * N;
+    _occupied   = 0;
+    _legal      = 0;
     _score      = _higher = _moves = 0;
     _spawned    = false;
+    _unsaved    = false;
     _state      = State::INIT;
 
+    _games++;
+
 }
 
-void Game::_init() {
+template <uint8_t N>
+void Game<N>::_init() {
 
-    static Tile *t1 = nullptr;
-    static Tile *t2 = nullptr;
+    static Handle t1 = Tiles::NONE;
+    static Handle t2 = Tiles::NONE;
 
     if (!_spawned) {
         _spawned = true;
@@ -266,263 +446,584 @@ void Game::_init() {
         t2       = _spawnTile();
     }
 
-    if (t1->arising) t1->arise();
-    if (t2->arising) t2->arise();
+    if (_tiles.arising(t1)) _tiles.arise(t1);
+    if (_tiles.arising(t2)) _tiles.arise(t2);
 
-    if (!t1->arising && !t2->arising) _state = State::PLAY;
+    if (!_tiles.arising(t1) && !_tiles.arising(t2)) _state = State::PLAY;
 
 }
 
-void Game::_spawn() {
-
-    static Tile *t = nullptr;
-
-    if (!_spawned) {
-        _spawned = true;
-        t        = _spawnTile();
-    }
+template <uint8_t N>
+void Game<N>::_spawn() {
 
-    if (t->arising) {
-        t->arise();
-    } else if (_free_tiles == 0 && !_isSqueezable()) {
+    if (_tiles.arising(_arising)) {
+        _tiles.arise(_arising);
+    } else if (_legal == 0) {
+        _log.close(_score, _higher);
         espboy.pixel.flash(Color::hsv2rgb(0), 100, 5, 200);
         _state = State::LOST;
         _last  = millis();
     } else {
         _state = State::PLAY;
+        _last  = millis();
     }
 
 }
 
-void Game::_play() {
-
-         if (espboy.button.pressed(Button::LEFT))  _move(Direction::LEFT);
-    else if (espboy.button.pressed(Button::UP))    _move(Direction::UP);
-    else if (espboy.button.pressed(Button::RIGHT)) _move(Direction::RIGHT);
-    else if (espboy.button.pressed(Button::DOWN))  _move(Direction::DOWN);
+template <uint8_t N>
+void Game<N>::_play() {
 
-}
+    // Presses buffered during the animations are played in order, one move
+    // per tick. Directions that would leave the board unchanged are dropped.
+    InputQueue::Event e;
+    while (_input.pop(e)) {
 
-Tile *Game::_spawnTile() {
+        if (e.button == Button::ESC) {
+            _undo();
+            return;
+        }
 
-    uint8_t i, j;
-    Tile *t;
-    do { t = _board[i = random(4)][j = random(4)]; } while (t != nullptr);
+        if (e.button == Button::ACT) {
+            _hinting = !_hinting;
+            continue;
+        }
 
-    _free_tiles--;
+        int8_t d = _direction(e.button);
+        if (d >= 0 && (_legal & (1 << d))) {
+            _input.served(e);
+            _move(static_cast<Direction>(d));
+            return;
+        }
 
-    if (_phantom_count) {
-        t = _phantom[--_phantom_count];
-        t->init(i, j);
-    } else {
-        t = new Tile(i, j);
     }
 
-    return _board[i][j] = t;
+    // Saving only once the player pauses spares the flash a write per move.
+    if (_unsaved && millis() - _last >= _AUTOSAVE_DELAY) _saveGame();
 
 }
 
-void Game::_slide(uint8_t const i) {
+template <uint8_t N>
+int8_t Game<N>::_direction(Button const b) {
 
-    for (uint8_t j = 0; j < 3; ++j) {
-        uint8_t k = 1;
-        if (_board[i][j] == nullptr) {
+    switch (b) {
+        case Button::LEFT:  return static_cast<int8_t>(Direction::LEFT);
+        case Button::UP:    return static_cast<int8_t>(Direction::UP);
+        case Button::RIGHT: return static_cast<int8_t>(Direction::RIGHT);
+        case Button::DOWN:  return static_cast<int8_t>(Direction::DOWN);
+        default:            return -1;
+    }
 
-            while ((_board[i][j+k] == nullptr) && (j+k < 4)) k++;
+}
 
-            if (j+k < 4) {
-                _board[i][j]          = _board[i][j+k];
-                _board[i][j+k]        = nullptr;
-                _board[i][j]->sliding = true;
-                _slided               = true;
-            }
+template <uint8_t N>
+bool Game<N>::_interrupt() {
 
+    // The board is already settled logically: a move or an undo pressed in
+    // the middle of an animation cuts it short and is played at once.
+    InputQueue::Event e;
+    while (_input.peek(e)) {
+
+        int8_t d = _direction(e.button);
+
+        if (e.button == Button::ESC || (d >= 0 && (_legal & (1 << d)))) {
+            _settle();
+            _state = State::PLAY;
+            _play();
+            return true;
         }
+
+        if (e.button == Button::ACT) _hinting = !_hinting;
+
+        _input.pop(e);
+
     }
 
+    return false;
+
 }
 
-void Game::_collapse(uint8_t const i) {
+template <uint8_t N>
+void Game<N>::_settle() {
 
-    Tile *t, *tt;
-    for (uint8_t j = 0; j < 3; ++j) {
+    Mask live = _tiles.live();
 
-        t  = _board[i][j];
-        tt = _board[i][j+1];
+    for (Handle t = 0; t < Tiles::CAPACITY; ++t) {
+        if (live & ((Mask)1 << t)) _tiles.settle(t);
+    }
 
-        if (t != nullptr && tt != nullptr && t->pow2 == tt->pow2) {
+    // The collapsers are retired now, so the spawned tile may take a slot.
+    if (_state == State::SLIDING) _showSpawn(false);
 
-            _phantom[_phantom_count] = tt;
-            _phantom_count++;
+}
 
-            _board[i][j+1] = nullptr;
-            _free_tiles++;
+template <uint8_t N>
+void Game<N>::_think() {
 
-            t->pow2++;
-            t->collapser  = tt;
-            t->collapsing = true;
-            t->sliding    = true;
+    // The board is settled as soon as a move is played, so the search for
+    // the next one starts while the tiles are still moving.
+    bool active = _hinting && _legal && (_state == State::PLAY || _state == State::SLIDING || _state == State::SPAWN);
 
-            _collapsed = true;
-            _slided    = true;
+    if (!active) { _showHint(-1); return; }
 
-            if (t->pow2 == 11) espboy.pixel.rainbow(1000, 2);
+    if (!_hint.covers(_grid)) {
+        _showHint(-1);
+        _hint.start(_grid, _legal);
+    }
 
-            if (t->pow2 > _higher) _higher = t->pow2;
-            _score += 1 << t->pow2;
+    { PROFILE_SCOPE(HINT); _hint.think(); }
 
-        }
+    if (_hint.ready()) _showHint(static_cast<int8_t>(_hint.best()));
 
+}
+
+template <uint8_t N>
+void Game<N>::_showHint(int8_t const d) {
+
+    if (d == _hinted) return;
+
+    if (_hinted >= 0) _dirty.add(_hintBar(_hinted));
+    if (d >= 0)       _dirty.add(_hintBar(d));
+
+    _hinted = d;
+
+}
+
+template <uint8_t N>
+Rect Game<N>::_hintBar(int8_t const d) {
+
+    // A thin bar in the middle of the outer gap, along the whole board.
+    Rect    c    = Tiles::cell(0, 0);
+    int16_t gap  = c.x;
+    int16_t bar  = gap > 2 ? 2 : 1;
+    int16_t off  = (gap - bar) >> 1;
+    int16_t size = TFT_WIDTH - (gap << 1);
+
+    switch (static_cast<Direction>(d)) {
+        case Direction::LEFT:  return Rect(off, gap, bar, size);
+        case Direction::UP:    return Rect(gap, off, size, bar);
+        case Direction::RIGHT: return Rect(TFT_WIDTH - off - bar, gap, bar, size);
+        default:               return Rect(gap, TFT_HEIGHT - off - bar, size, bar);
     }
 
 }
 
-void Game::_tweak(Transform const t) {
+template <uint8_t N>
+typename Game<N>::Handle Game<N>::_spawnTile() {
 
-    Tile *b[4][4]; memcpy(b, _board, 16 * sizeof(Tile*));
+    _commitSpawn();
 
-    for (uint8_t i = 0; i < 4; ++i) {
-        for (uint8_t j = 0; j < 4; ++j) {
-            switch (t) {
-                case Transform::HORIZONTAL_FLIP: _board[i][j] = b[i][3-j]; break;
-                case Transform::LEFT_ROTATION:   _board[i][j] = b[j][3-i]; break;
-                case Transform::RIGHT_ROTATION:  _board[i][j] = b[3-j][i];
-            }
-        }
-    }
+    return _showSpawn(true);
 
 }
 
-void Game::_move(Direction const d) {
+template <uint8_t N>
+void Game<N>::_commitSpawn() {
 
-    _slided = _collapsed = false;
+    uint8_t c = _grid.spawn(_rng);
+    uint8_t p = _grid.get(c / N, c % N);
 
-    switch (d) {
-        case Direction::LEFT:  _slideLeft();  break;
-        case Direction::UP:    _slideUp();    break;
-        case Direction::RIGHT: _slideRight(); break;
-        case Direction::DOWN:  _slideDown();
-    }
+    _delta.spawned(c, p);
+    _free_tiles--;
+    _occupied |= (Mask)1 << c;
+
+    if (p > _higher) _higher = p;
 
-    if (_slided || _collapsed) { _state = State::SLIDING; return; }
+    // The next turn is played out in advance, which tells at once whether
+    // the game is lost and spares the input path any useless slide.
+    _legal = _grid.moves(_next, _gain);
 
 }
 
-void Game::_showMove() {
+template <uint8_t N>
+typename Game<N>::Handle Game<N>::_showSpawn(bool const arise) {
 
-    Tile *t;
-    bool slided    = false;
-    bool collapsed = false;
+    // The spawn is always the last event of the turn.
+    typename Delta<N>::Event const &e = _delta[_delta.size() - 1];
 
-    for (uint8_t i = 0; i < 4; ++i) {
-        for (uint8_t j = 0; j < 4; ++j) {
+    uint8_t i = e.to / N;
+    uint8_t j = e.to % N;
+
+    return _board[i][j] = arise ? _tiles.spawn(i, j, e.pow2) : _tiles.place(i, j, e.pow2);
 
-            if ((t = _board[i][j]) != nullptr) {
+}
 
-                if (t->sliding) {
-                    t->slide(i, j);
-                    slided = true;
-                } else if (t->collapsing) {
-                    t->collapse();
-                    collapsed = true;
-                }
+template <uint8_t N>
+void Game<N>::_rebuild(bool const arise) {
 
-            }
+    _tiles.clear();
 
+    for (uint8_t i = 0; i < N; ++i) {
+        for (uint8_t j = 0; j < N; ++j) {
+            uint8_t p = _grid.get(i, j);
+            if (p == 0)     _board[i][j] = Tiles::NONE;
+            else if (arise) _board[i][j] = _tiles.spawn(i, j, p);
+            else            _board[i][j] = _tiles.place(i, j, p);
         }
     }
 
-    if (!slided && !collapsed) {
-        _moves++;
-        _spawned = false;
-        _state   = State::SPAWN;
-    }
+    _free_tiles = _grid.freeCells();
+    _occupied   = _grid.occupancy();
+    _legal      = _grid.moves(_next, _gain);
+    _dirty      = Rect(0, 0, TFT_WIDTH, TFT_HEIGHT);
 
 }
 
-void Game::_slideLeft() {
+template <uint8_t N>
+bool Game<N>::_undo() {
+
+    typename History<N>::Entry e;
+
+    if (!_history.pop(e)) return false;
+
+    // The position is laid out at once, without any slide or merge.
+    _log.undo();
+    _rng.seed(e.seed);
+
+    _grid = e.grid;
+    _rebuild(false);
+
+    _score  -= e.gain;
+    _higher  = e.higher;
+    _moves--;
+    _unsaved = true;
+    _last    = millis();
+    _state   = State::PLAY;
+
+    return true;
+
+}
+
+template <uint8_t N>
+void Game<N>::_move(Direction const d) {
+
+    Board<N> const &next = _next[static_cast<uint8_t>(d)];
+
+    _delta.record(_grid, d, next, _gain[static_cast<uint8_t>(d)]);
+
+    _log.record(d);
+    _history.push(_grid, _delta.gain, _rng.state(), _higher);
+
+    _animate();
+
+    _grid     = next;
+    _occupied = next.occupancy();
+    _score   += _delta.gain;
+    _unsaved  = true;
+    _state    = State::SLIDING;
+
+    _moves++;
+
+    // The whole turn is committed right away, the spawned tile only shows
+    // up once the others have come to rest.
+    _commitSpawn();
+
+}
+
+template <uint8_t N>
+void Game<N>::_animate() {
+
+    // Only the tiles the move has touched are set in motion. The events of a
+    // line come in order, so that a tile merging into another one always
+    // finds it already standing on its final cell.
+    for (typename Delta<N>::Event const &e : _delta) {
+
+        if (e.kind == Delta<N>::Event::SPAWN) continue;
+
+        uint8_t i = e.to / N;
+        uint8_t j = e.to % N;
+        Handle  t = _board[e.from / N][e.from % N];
+
+        _board[e.from / N][e.from % N] = Tiles::NONE;
+
+        if (e.kind == Delta<N>::Event::SLIDE) {
+            _tiles.slideTo(_board[i][j] = t, i, j);
+            continue;
+        }
+
+        _tiles.merge(_board[i][j], t, i, j);
+        _free_tiles++;
+
+        if (e.pow2 == 11) espboy.pixel.rainbow(1000, 2);
+
+        if (e.pow2 > _higher) _higher = e.pow2;
 
-    for (uint8_t i = 0; i < 4; ++i) {
-        _slide(i);
-        _collapse(i);
-        _slide(i);
     }
 
 }
 
-void Game::_slideRight() { _tweak(Transform::HORIZONTAL_FLIP); _slideLeft(); _tweak(Transform::HORIZONTAL_FLIP); }
-void Game::_slideUp()    { _tweak(Transform::LEFT_ROTATION);   _slideLeft(); _tweak(Transform::RIGHT_ROTATION);  }
-void Game::_slideDown()  { _tweak(Transform::RIGHT_ROTATION);  _slideLeft(); _tweak(Transform::LEFT_ROTATION);   }
+template <uint8_t N>
+void Game<N>::_showMove() {
 
-bool Game::_isSqueezable() {
+    Mask live      = _tiles.live();
+    bool slided    = false;
+    bool collapsed = false;
 
-    for (uint8_t i = 0; i < 4; ++i) {
-        for (uint8_t j = 0; j < 4; ++j) {
-            if (i < 3 && _board[i][j]->pow2 == _board[i+1][j]->pow2) return true;
-            if (j < 3 && _board[i][j]->pow2 == _board[i][j+1]->pow2) return true;
+    for (Handle t = 0; t < Tiles::CAPACITY; ++t) {
+
+        if (!(live & ((Mask)1 << t))) continue;
+
+        if (_tiles.sliding(t)) {
+            _tiles.slide(t);
+            slided = true;
+        } else if (_tiles.collapsing(t)) {
+            _tiles.collapse(t);
+            collapsed = true;
         }
+
     }
 
-    return false;
+    if (!slided && !collapsed) {
+        _arising = _showSpawn(true);
+        _state   = State::SPAWN;
+    }
 
 }
 
-void Game::_lost() {
+template <uint8_t N>
+void Game<N>::_lost() {
+
+    // The losing move can still be taken back before the game is over.
+    if (_pressed(Button::ESC) && _undo()) return;
 
     if (millis() - _last < 2000) return;
 
-    _saveHighScore();
+    _endGame();
+    _fadeOut(State::GAME_OVER);
+
+}
 
-    memcpy(_phantom, _board, 16 * sizeof(Tile*));
-    _phantom_count = 16;
+template <uint8_t N>
+void Game<N>::_gameOver() {
 
-    espboy.fadeOut(); while (espboy.fading()) espboy.update();
-    espboy.fadeIn();
+    if (_pressed(Button::ACT)) {
 
-    _state = State::GAME_OVER;
+        _dirty = Rect(0, 0, TFT_WIDTH, TFT_HEIGHT);
+        _fadeOut(State::START);
+
+    }
 
 }
 
-void Game::_gameOver() {
+template <uint8_t N>
+void Game<N>::_fadeOut(State const next) {
 
-    if (espboy.button.pressed(Button::ACT)) {
+    espboy.fadeOut();
 
-        espboy.fadeOut(); while (espboy.fading()) espboy.update();
-        espboy.fadeIn();
+    _faded = next;
+    _state = State::FADING;
 
-        _state = State::START;
+}
+
+template <uint8_t N>
+void Game<N>::_fading() {
+
+    // The backlight is dimmed by espboy.update() on every loop, the screen
+    // being left as it is, and nothing pressed meanwhile is kept.
+    _input.clear();
+
+    if (espboy.fading()) return;
+
+    espboy.fadeIn();
+    _state = _faded;
 
+}
+
+template <uint8_t N>
+bool Game<N>::_pressed(Button const b) {
+
+    // Waiting for a single button, any other one is simply discarded.
+    InputQueue::Event e;
+    while (_input.pop(e)) {
+        if (e.button == b) return true;
     }
 
+    return false;
+
 }
 
-void Game::_loadHighScore() {
+template <uint8_t N>
+void Game<N>::_load() {
 
-    EEPROM.begin(sizeof(EEPROM_Data));
+    EEPROM.begin(_EEPROM_SIZE);
 
     if (EEPROM.percentUsed() >= 0) {
         EEPROM.get(_EEPROM_ADDR, _backup_data);
-        if (strcmp(_backup_data.tag, _EEPROM_DATA_TAG) == 0) return;
+        if (strcmp(_backup_data.tag, _EEPROM_DATA_TAG) == 0) {
+            // A game saved on a board of another size cannot be resumed,
+            // but the high scores of every size are kept.
+            if (_backup_data.size != N) {
+                _backup_data.size = N;
+                _backup_data.game = Snapshot();
+            }
+            return;
+        }
     }
 
+    _backup_data = EEPROM_Data();
+    _backup_data.size = N;
     strncpy((char*)&_backup_data.tag, _EEPROM_DATA_TAG, sizeof(_EEPROM_DATA_TAG));
-    _backup_data.highscore = 0;
+
+    // The high score and game saved by a former build are written over at
+    // once in the current record, which replaces theirs for good.
+    if (_loadOld()) {
+        EEPROM.put(_EEPROM_ADDR, _backup_data);
+        EEPROM.commit();
+    }
+
+}
+
+template <uint8_t N>
+bool Game<N>::_loadOld() {
+
+    EEPROM_Old old;
+    bool       found = false;
+
+    // ESP_EEPROM only finds a record back under the size it was written with.
+    EEPROM.end();
+    EEPROM.begin(_EEPROM_ADDR + sizeof(EEPROM_Old));
+
+    if (EEPROM.percentUsed() >= 0) {
+        EEPROM.get(_EEPROM_ADDR, old);
+        found = memcmp(old.tag, _EEPROM_OLD_TAG, sizeof(_EEPROM_OLD_TAG)) == 0 && old.size == N;
+    }
+
+    EEPROM.end();
+    EEPROM.begin(_EEPROM_SIZE);
+
+    if (!found) return false;
+
+    _backup_data.highscore[N - 3] = old.highscore;
+    _backup_data.game             = old.game;
+
+    return true;
+
+}
+
+template <uint8_t N>
+bool Game<N>::_restore() {
+
+    Snapshot const &s = _backup_data.game;
+
+    if (s.check != _checksum(s)) return false;
+
+    if (s.grid.moves(_next) == 0) return false;
+
+    _rng.seed(s.seed);
+    _log.resume(s.seed);
+    _history.clear();
+
+    _grid = s.grid;
+    _rebuild(true);
+
+    _score   = s.score;
+    _moves   = s.moves;
+    _higher  = s.higher;
+    _unsaved = false;
+
+    return true;
 
 }
 
-void Game::_saveHighScore() {
+template <uint8_t N>
+void Game<N>::_saveGame() {
+
+    Snapshot &s = _backup_data.game;
 
-    if (_score > _backup_data.highscore) {
+    s.grid   = _grid;
+    s.score  = _score;
+    s.moves  = _moves;
+    s.seed   = _rng.state();
+    s.higher = _higher;
+    s.check  = _checksum(s);
+
+    EEPROM.put(_EEPROM_ADDR, _backup_data);
+    EEPROM.commit();
+
+    _unsaved = false;
+
+}
 
-        _backup_data.highscore = _score;
+template <uint8_t N>
+void Game<N>::_endGame() {
 
+    bool commit = _backup_data.game.check == _checksum(_backup_data.game);
+
+    // A lost game must not be resumed.
+    if (commit) _backup_data.game = Snapshot();
+
+    if (_score > _backup_data.highscore[N - 3]) {
+        _backup_data.highscore[N - 3] = _score;
+        commit = true;
+    }
+
+    if (commit) {
         EEPROM.put(_EEPROM_ADDR, _backup_data);
         EEPROM.commit();
+    }
+
+}
 
+template <uint8_t N>
+uint32_t Game<N>::_checksum(Snapshot const &s) {
+
+    // FNV-1a over the fields one by one, so that padding bytes are left out.
+    struct Field { void const *data; uint8_t size; };
+
+    Field const fields[] = {
+        { &s.grid,   sizeof(s.grid)   },
+        { &s.score,  sizeof(s.score)  },
+        { &s.moves,  sizeof(s.moves)  },
+        { &s.seed,   sizeof(s.seed)   },
+        { &s.higher, sizeof(s.higher) }
+    };
+
+    uint32_t h = 0x811c9dc5;
+
+    for (Field const &f : fields) {
+        uint8_t const *b = static_cast<uint8_t const *>(f.data);
+        for (uint8_t k = 0; k < f.size; ++k) h = (h ^ b[k]) * 0x01000193;
     }
 
+    return h;
+
 }
 
+// -----------------------------------------------------------------------------
+// Profiling
+// -----------------------------------------------------------------------------
+
+#ifdef PROFILE
+
+template <uint8_t N>
+char const * const Game<N>::_STATE_NAMES[] = {
+    "splash",
+    "launch",
+    "resume",
+    "start",
+    "init",
+    "spawn",
+    "play",
+    "sliding",
+    "lost",
+    "game over",
+    "fading"
+};
+
+template <uint8_t N>
+void Game<N>::profile() const {
+
+#ifdef ESP8266
+    Serial.printf("heap       %u bytes free, %u in the largest block\n", ESP.getFreeHeap(), ESP.getMaxFreeBlockSize());
+#endif
+
+    Profiler::dump(_STATE_NAMES, sizeof(_STATE_NAMES) / sizeof(_STATE_NAMES[0]));
+
+}
+
+#endif
+
+template class Game<BOARD_SIZE>;
+
 /**
  * -----------------------------------------------------------------------------
  * 2048 Game
@@ -3,112 +3,255 @@
  * @file   Game.h
  * @author Stéphane Calderoni (https://github.com/m1cr0lab)
  * @brief  Game engine
+ *
+ * @note The board size is a template parameter, so that every loop bound,
+ *       cell position and arena size is known at compile time. The game is
+ *       only instantiated for the `BOARD_SIZE` the firmware is built for.
+ *
+ *       The game in progress is saved whenever the player pauses, so that it
+ *       can be resumed right after a reset. Each board size keeps a high
+ *       score of its own in the same EEPROM record, and the one saved by the
+ *       builds that only kept a single high score is carried over on first
+ *       boot. The EEPROM image is kept small, since ESP_EEPROM appends every
+ *       commit to the next free slot of its flash sector and only erases the
+ *       sector once it is full.
+ *
+ *       The [ESC] button takes back the last moves, up to `UNDO_DEPTH`, and
+ *       the [ACT] button turns on or off the hint, which lights up the edge
+ *       of the board the tiles had better be pushed to.
+ *
+ *       Frames are composed one band of `RENDER_BAND_ROWS` rows at a time,
+ *       into a frame buffer that only holds one band. Only the tiles that
+ *       overlap a band are drawn into it. The band is 16 rows high by
+ *       default, which trades a few more draw calls for 28 KB of RAM on the
+ *       splash screen and 14 KB during the game.
+ *       The empty board behind the tiles is copied from a retained image
+ *       instead of being repainted.
  * -----------------------------------------------------------------------------
  */
 
 #pragma once
 
 #include <ESPboy.h>
-#include "Tile.h"
+#include "Background.h"
+#include "Board.h"
+#include "Delta.h"
+#include "Hint.h"
+#include "History.h"
+#include "InputQueue.h"
+#include "MoveLog.h"
+#include "Display.h"
+#include "Profiler.h"
+#include "Prng.h"
+#include "Rect.h"
+#include "Ticker.h"
+#include "TileArena.h"
 
+#ifndef RENDER_BAND_ROWS
+#define RENDER_BAND_ROWS 16 // TFT_HEIGHT composes the whole frame at once
+#endif
+
+template <uint8_t N>
 class Game {
 
+    typedef TileArena<N>            Tiles;
+    typedef typename Tiles::Handle  Handle;
+    typedef typename Board<N>::Mask Mask;
+
     public:
 
         void begin();
         void loop();
+        void seed(uint32_t const seed) { _rng.seed(seed); }
+        void display(Display * const d) { _display = d; }
+
+        Board<N> board()    const { return _grid;     }
+        Mask     occupied() const { return _occupied; }
+        uint32_t score()    const { return _score;    }
+        uint32_t higher()   const { return _higher;   }
+        uint32_t moves()    const { return _moves;    }
+        uint32_t games()    const { return _games;    } // started since boot
+        bool     playing()  const { return _state == State::PLAY; }
+        bool     waiting()  const { return _state == State::LAUNCH || _state == State::GAME_OVER; }
+        uint8_t  legal()    const { return _legal;    }
+
+        Board<N> successor(Direction const d) const { return _next[static_cast<uint8_t>(d)]; }
+
+        MoveLog const &log() const { return _log; }
+
+        InputQueue const &input() const { return _input; }
+
+        Hint<N> const &hint() const { return _hint; }
+
+        Background const &background() const { return _background; }
+
+        uint32_t frameTime()    const { return _ticker.frameTime(); }
+        uint32_t droppedTicks() const { return _ticker.dropped();   }
+
+#ifdef PROFILE
+        void profile() const;
+#endif
 
     private:
 
         static uint8_t    constexpr _EEPROM_ADDR       = 1;
-        static char const constexpr _EEPROM_DATA_TAG[] = "2048";
+        static char const constexpr _EEPROM_DATA_TAG[] = "2048v2";
+        static char const constexpr _EEPROM_OLD_TAG[]  = "2048";
+        static uint16_t   constexpr _TICK_PERIOD       = 16667; // 60 Hz
+        static uint16_t   constexpr _AUTOSAVE_DELAY    = 1500;  // ms
+
+        struct Snapshot {
+            Board<N> grid;
+            uint32_t score;
+            uint32_t moves;
+            uint32_t seed;
+            uint8_t  higher;
+            uint32_t check;
+        };
 
+        // The high scores come first, one per board size, so that they keep
+        // the same place whatever the size the firmware is built for.
         struct EEPROM_Data {
-            char     tag[5];
-            uint16_t highscore;
+            char     tag[sizeof(_EEPROM_DATA_TAG)];
+            uint8_t  size;
+            uint32_t highscore[6];
+            Snapshot game;
         };
 
+        // The record of the builds that kept a single high score, sized to
+        // fit it exactly, which is read back once to carry it over.
+        struct EEPROM_Old {
+            char     tag[sizeof(_EEPROM_OLD_TAG)];
+            uint8_t  size;
+            uint32_t highscore;
+            Snapshot game;
+        };
+
+        // ESP_EEPROM has to be given the same size by every build to find the
+        // record back, so it is sized once and for all for the 8x8 board.
+        static uint8_t constexpr _EEPROM_SIZE = 128;
+
+        static_assert(_EEPROM_ADDR + sizeof(EEPROM_Data) <= _EEPROM_SIZE, "the EEPROM record does not fit");
+
         enum class State : uint8_t {
             SPLASH,
             LAUNCH,
+            RESUME,
             START,
             INIT,
             SPAWN,
             PLAY,
             SLIDING,
             LOST,
-            GAME_OVER
+            GAME_OVER,
+            FADING
         };
 
-        enum class Direction : uint8_t {
-            LEFT,
-            UP,
-            RIGHT,
-            DOWN
-        };
-
-        enum class Transform : uint8_t {
-            HORIZONTAL_FLIP,
-            LEFT_ROTATION,
-            RIGHT_ROTATION
-        };
+#ifdef PROFILE
+        static char const * const _STATE_NAMES[static_cast<uint8_t>(State::FADING) + 1];
+#endif
 
         EEPROM_Data _backup_data;
 
         LGFX_Sprite *_fb;
+        Background   _background;
+        TftDisplay   _tft;
+        Display     *_display = &_tft;
+        Ticker       _ticker;
+        InputQueue   _input;
+
+        Board<N> _grid;
+        Delta<N> _delta;
+        Prng     _rng;
+        MoveLog  _log;
 
-        Tile *_board[4][4] = { nullptr };
-        Tile *_phantom[16] = { nullptr };
+        DirtyRects _dirty;
+
+        History<N> _history;
+
+        Hint<N> _hint;
+        bool    _hinting;
+        int8_t  _hinted; // direction lit up, or -1
+
+        Tiles  _tiles;
+        Handle _board[N][N];
 
         uint8_t  _splash_step;
         uint8_t  _splash_tiles_y[4];
         uint32_t _last;
 
-        uint8_t  _phantom_count;
         uint8_t  _free_tiles;
+        Mask     _occupied;
+        uint8_t  _legal;
+        Board<N> _next[4];
+        uint32_t _gain[4];
         uint32_t _score;
         uint32_t _higher;
         uint32_t _moves;
+        uint32_t _games;
         bool     _spawned;
-        bool     _slided;
-        bool     _collapsed;
+        Handle   _arising;
+        bool     _unsaved;
         State    _state;
+        State    _faded;
 
         void _initSplashFrameBuffer();
         void _initPlayFrameBuffer();
 
+        void _tick();
         void _update();
-        void _draw();
+        void _draw(bool const ticked);
+        void _splash();
         void _drawSplash();
         void _drawBoard();
         void _drawGameOver();
+        void _paintSplash(int16_t const oy);
+        void _paintBoard(Rect const &d, int16_t const oy);
+        void _paintBackground(Rect const &d, int16_t const oy);
+        void _paintGameOver(int16_t const oy);
 
         void _launch();
+        void _resume();
         void _start();
         void _init();
         void _spawn();
         void _play();
 
-        Tile *_spawnTile();
+        Handle _spawnTile();
+        void   _commitSpawn();
+        Handle _showSpawn(bool const arise);
 
-        void _slide(uint8_t const i);
-        void _collapse(uint8_t const i);
-        void _tweak(Transform const t);
-        void _move(Direction const d);
-        void _showMove();
+        static int8_t _direction(Button const b);
+
+        bool _interrupt();
+        void _settle();
+
+        void _think();
+        void _showHint(int8_t const d);
+
+        static Rect _hintBar(int8_t const d);
 
-        void _slideLeft();
-        void _slideRight();
-        void _slideUp();
-        void _slideDown();
+        void _rebuild(bool const arise);
+        bool _undo();
 
-        bool _isSqueezable();
+        void _move(Direction const d);
+        void _animate();
+        void _showMove();
 
         void _lost();
         void _gameOver();
+        void _fadeOut(State const next);
+        void _fading();
+
+        bool _pressed(Button const b);
+
+        void _load();
+        bool _loadOld();
+        bool _restore();
+        void _saveGame();
+        void _endGame();
 
-        void _loadHighScore();
-        void _saveHighScore();
+        static uint32_t _checksum(Snapshot const &s);
 
 };
 
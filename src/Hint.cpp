@@ -0,0 +1,219 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Hint.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Time-sliced expectimax search for the next best move
+ * -----------------------------------------------------------------------------
+ */
+
+#include "Hint.h"
+
+template <uint8_t N>
+void Hint<N>::start(Board<N> const &b, uint8_t const legal) {
+
+    _root    = b;
+    _legal   = legal;
+    _depth   = 0;
+    _target  = 1;
+    _sp      = 0;
+    _since   = millis();
+    _started = true;
+    _done    = legal == 0;
+
+    if (!_done) _push(b, 1, 1, false);
+
+}
+
+template <uint8_t N>
+void Hint<N>::think() {
+
+    uint32_t t0 = ESP.getCycleCount();
+
+    while (!_done && ESP.getCycleCount() - t0 < HINT_BUDGET) _step();
+
+    // Past the deadline, the level under way is given up, unless it is the
+    // first one: some answer is always better than none.
+    if (!_done && _depth > 0 && millis() - _since >= HINT_LATENCY) _close();
+
+}
+
+template <uint8_t N>
+void Hint<N>::_push(Board<N> const &b, uint8_t const depth, float const prob, bool const chance) {
+
+    Frame &f = _stack[_sp++];
+
+    f.board  = b;
+    f.value  = 0;
+    f.prob   = prob;
+    f.depth  = depth;
+    f.next   = 0;
+    f.chance = chance;
+
+    if (chance) {
+        Mask full = Board<N>::CELLS == sizeof(Mask) * 8 ? (Mask)~0 : ((Mask)1 << Board<N>::CELLS) - 1;
+        f.free    = ~b.occupancy() & full;
+        f.cells   = __builtin_popcountll(f.free);
+    }
+
+    _stats.nodes++;
+
+}
+
+template <uint8_t N>
+void Hint<N>::_step() {
+
+    Frame &f = _stack[_sp - 1];
+
+    if (f.chance) {
+
+        if (f.free == 0) {
+            float v = f.value / f.cells;
+            _sp--;
+            _deliver(v);
+            return;
+        }
+
+        // Each free cell gets a 2, then a 4.
+        uint8_t  c = __builtin_ctzll(f.free);
+        Board<N> b = f.board;
+        b.set(c / N, c % N, f.next + 1);
+
+        _push(b, f.depth, f.prob * (f.next ? _PROB_FOUR : _PROB_TWO) / f.cells, false);
+
+        return;
+
+    }
+
+    while (f.next < 4) {
+
+        Board<N> b = f.board.move(static_cast<Direction>(f.next++));
+        if (b == f.board) continue;
+
+        // Unlikely spawns are not worth looking further into.
+        if (f.depth == 1 || f.prob < _PROB_CUTOFF) {
+            _stats.nodes++;
+            _deliver(_evaluate(b));
+        } else {
+            _push(b, f.depth - 1, f.prob, true);
+        }
+
+        return;
+
+    }
+
+    // A position without any legal move is worth nothing.
+    float v = f.value;
+    _sp--;
+
+    if (_sp == 0) _finish(); else _deliver(v);
+
+}
+
+template <uint8_t N>
+void Hint<N>::_deliver(float const value) {
+
+    Frame &f = _stack[_sp - 1];
+
+    if (f.chance) {
+        f.value += (f.next ? _PROB_FOUR : _PROB_TWO) * value;
+        if (f.next) { f.next = 0; f.free &= f.free - 1; } else f.next = 1;
+        return;
+    }
+
+    if (_sp == 1) _scores[f.next - 1] = value;
+    if (value > f.value) f.value = value;
+
+}
+
+template <uint8_t N>
+void Hint<N>::_finish() {
+
+    float top = -1;
+
+    for (uint8_t d = 0; d < 4; ++d) {
+        if ((_legal & (1 << d)) && _scores[d] > top) {
+            top   = _scores[d];
+            _best = static_cast<Direction>(d);
+        }
+    }
+
+    _depth = _target;
+
+    if (_target < HINT_DEPTH && millis() - _since < HINT_LATENCY) _push(_root, ++_target, 1, false);
+    else _close();
+
+}
+
+template <uint8_t N>
+void Hint<N>::_close() {
+
+    _done = true;
+
+    _stats.searches++;
+    _stats.depths += _depth;
+    if (_depth > _stats.deepest) _stats.deepest = _depth;
+
+}
+
+template <uint8_t N>
+float Hint<N>::_evaluate(Board<N> const &b) {
+
+    // Empty cells and neighbours that may merge are rewarded, rows and
+    // columns that are sorted neither way are penalized.
+    int16_t empty  = 0;
+    int16_t merges = 0;
+    int16_t mess   = 0;
+
+    for (uint8_t k = 0; k < N; ++k) {
+
+        int16_t up[2]   = { 0, 0 };
+        int16_t down[2] = { 0, 0 };
+
+        for (uint8_t r = 0; r < N; ++r) {
+
+            uint8_t p = b.get(k, r);
+            if (p == 0) empty++;
+            if (r == 0) continue;
+
+            uint8_t line[2][2] = { { b.get(k, r - 1), p }, { b.get(r - 1, k), b.get(r, k) } };
+
+            for (uint8_t o = 0; o < 2; ++o) {
+                uint8_t a = line[o][0];
+                uint8_t c = line[o][1];
+                if (a != 0 && a == c) merges++;
+                if (a < c) up[o] += c - a; else down[o] += a - c;
+            }
+
+        }
+
+        mess += min(up[0], down[0]) + min(up[1], down[1]);
+
+    }
+
+    return 10000 + 20 * empty + 10 * merges - 3 * mess;
+
+}
+
+template class Hint<BOARD_SIZE>;
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,127 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Hint.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Time-sliced expectimax search for the next best move
+ *
+ * @note The search runs on the console itself, next to the game, and never
+ *       holds a frame for long: it walks the game tree with an explicit stack
+ *       of fixed size, and gives control back after `HINT_BUDGET` CPU cycles
+ *       to carry on at the next loop. The tree is searched one move deeper at
+ *       a time, so that an answer is ready as soon as the first level is
+ *       done, then refined by each level completed until `HINT_LATENCY` is
+ *       over or `HINT_DEPTH` is reached.
+ *
+ *       Unlike the host solver, positions are rated on the fly without any
+ *       lookup table or transposition table, which keeps the whole search
+ *       state within a few hundred bytes and off the heap.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "Board.h"
+
+#ifndef HINT_BUDGET
+#define HINT_BUDGET 240000 // CPU cycles per loop, 3 ms at 80 MHz
+#endif
+
+#ifndef HINT_LATENCY
+#define HINT_LATENCY 200 // ms
+#endif
+
+#ifndef HINT_DEPTH
+#define HINT_DEPTH 4 // moves
+#endif
+
+template <uint8_t N>
+class Hint {
+
+    static_assert(HINT_DEPTH > 0 && HINT_DEPTH < 16, "the hint depth must range from 1 to 15");
+
+    typedef typename Board<N>::Mask Mask;
+
+    public:
+
+        struct Stats {
+            uint32_t searches;
+            uint32_t depths;  // sum of the depths reached
+            uint8_t  deepest;
+            uint64_t nodes;
+            float    depth() const { return searches ? (float)depths / searches : 0; }
+        };
+
+        void start(Board<N> const &b, uint8_t const legal);
+        void think();
+
+        bool covers(Board<N> const &b) const { return _started && b == _root; }
+        bool ready()                   const { return _depth > 0; }
+
+        Direction best()  const { return _best;  }
+        uint8_t   depth() const { return _depth; }
+
+        Stats const &stats() const { return _stats; }
+
+    private:
+
+        static float constexpr _PROB_CUTOFF = 1e-3f;
+        static float constexpr _PROB_TWO    = .9f;
+        static float constexpr _PROB_FOUR   = .1f;
+
+        // A player move node, or a spawn node when `chance` is set.
+        struct Frame {
+            Board<N> board;
+            float    value; // best child so far, or weighted sum of the children
+            float    prob;  // probability to reach this node
+            Mask     free;  // cells still to be spawned into
+            uint8_t  cells; // free cells at first
+            uint8_t  depth; // moves left to search
+            uint8_t  next;  // next direction to try, or 1 once the 2 is spawned
+            bool     chance;
+        };
+
+        Frame     _stack[2 * HINT_DEPTH];
+        uint8_t   _sp;
+        Board<N>  _root;
+        uint8_t   _legal;
+        uint8_t   _target;
+        float     _scores[4];
+        Direction _best;
+        uint8_t   _depth;
+        uint32_t  _since;
+        bool      _started = false;
+        bool      _done    = true;
+        Stats     _stats   = {};
+
+        void _push(Board<N> const &b, uint8_t const depth, float const prob, bool const chance);
+        void _step();
+        void _deliver(float const value);
+        void _finish();
+        void _close();
+
+        static float _evaluate(Board<N> const &b);
+
+};
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,97 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   History.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Fixed-size undo history
+ *
+ * @note The last `UNDO_DEPTH` positions are kept in a ring buffer, the oldest
+ *       one being overwritten once it is full, so that recording a move and
+ *       taking it back are both done in constant time without allocation.
+ *       Each entry holds the board before the move along with what is needed
+ *       to wind the game back: the score gained, the highest tile and the
+ *       generator state, which makes the same move spawn the same tile again.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "Board.h"
+
+#ifndef UNDO_DEPTH
+#define UNDO_DEPTH 16 // moves
+#endif
+
+template <uint8_t N>
+class History {
+
+    static_assert(UNDO_DEPTH > 0 && UNDO_DEPTH < 256, "the undo depth must range from 1 to 255");
+
+    public:
+
+        struct Entry {
+            Board<N> grid;
+            uint32_t gain;
+            uint32_t seed;
+            uint8_t  higher;
+        };
+
+        void clear() { _size = 0; }
+
+        uint8_t size() const { return _size; }
+
+        void push(Board<N> const &grid, uint32_t const gain, uint32_t const seed, uint8_t const higher) {
+
+            _head = _head == UNDO_DEPTH - 1 ? 0 : _head + 1;
+            if (_size < UNDO_DEPTH) _size++;
+
+            Entry &e = _ring[_head];
+
+            e.grid   = grid;
+            e.gain   = gain;
+            e.seed   = seed;
+            e.higher = higher;
+
+        }
+
+        bool pop(Entry &e) {
+
+            if (_size == 0) return false;
+
+            e     = _ring[_head];
+            _head = _head == 0 ? UNDO_DEPTH - 1 : _head - 1;
+            _size--;
+
+            return true;
+
+        }
+
+    private:
+
+        Entry   _ring[UNDO_DEPTH];
+        uint8_t _head = 0;
+        uint8_t _size = 0;
+
+};
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
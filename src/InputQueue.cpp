@@ -0,0 +1,82 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   InputQueue.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Bounded queue of timestamped button presses
+ * -----------------------------------------------------------------------------
+ */
+
+#include "InputQueue.h"
+
+void InputQueue::poll() {
+
+    uint32_t now = micros();
+
+    for (uint8_t b = 0; b < _BUTTONS; ++b) {
+
+        Button button = static_cast<Button>(b);
+
+        if (!espboy.button.pressed(button)) continue;
+
+        if (_size == INPUT_QUEUE_DEPTH) { _dropped++; continue; }
+
+        _events[(_head + _size) % INPUT_QUEUE_DEPTH] = { button, now };
+        _size++;
+
+    }
+
+}
+
+bool InputQueue::pop(Event &e) {
+
+    if (_size == 0) return false;
+
+    e     = _events[_head];
+    _head = (_head + 1) % INPUT_QUEUE_DEPTH;
+    _size--;
+
+    return true;
+
+}
+
+bool InputQueue::peek(Event &e) const {
+
+    if (_size == 0) return false;
+
+    e = _events[_head];
+
+    return true;
+
+}
+
+void InputQueue::served(Event const &e) {
+
+    uint32_t delay = micros() - e.at;
+
+    _latency.count++;
+    _latency.total += delay;
+    if (delay > _latency.worst) _latency.worst = delay;
+
+}
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,85 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   InputQueue.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Bounded queue of timestamped button presses
+ *
+ * @note The buttons are polled on every loop, whatever the game state, and
+ *       each new press is queued with the time it was seen. The state machine
+ *       then drains the presses in order once it is ready for them, so that a
+ *       direction pressed while the tiles are still sliding is played right
+ *       after instead of being lost. When the queue is full, the newest
+ *       presses are dropped: the game never runs too far ahead of the player.
+ *
+ *       The delay between a press and the move it triggers is accounted for,
+ *       which tells how responsive the game actually feels.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <ESPboy.h>
+
+#ifndef INPUT_QUEUE_DEPTH
+#define INPUT_QUEUE_DEPTH 8
+#endif
+
+class InputQueue {
+
+    public:
+
+        struct Event {
+            Button   button;
+            uint32_t at; // us
+        };
+
+        struct Latency {
+            uint32_t count;
+            uint64_t total; // us
+            uint32_t worst; // us
+            uint32_t average() const { return count ? total / count : 0; }
+        };
+
+        void poll();
+        bool pop(Event &e);
+        bool peek(Event &e) const;
+        void clear() { _size = 0; }
+        void served(Event const &e);
+
+        uint8_t        size()    const { return _size;    }
+        uint32_t       dropped() const { return _dropped; }
+        Latency const &latency() const { return _latency; }
+
+    private:
+
+        static uint8_t constexpr _BUTTONS = 6; // the directions, ACT and ESC
+
+        Event    _events[INPUT_QUEUE_DEPTH];
+        uint8_t  _head    = 0;
+        uint8_t  _size    = 0;
+        uint32_t _dropped = 0;
+        Latency  _latency = { 0, 0, 0 };
+
+};
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,90 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   MoveLog.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Compact record of a game session
+ * -----------------------------------------------------------------------------
+ */
+
+#include "MoveLog.h"
+
+void MoveLog::begin(uint32_t const seed) {
+
+    _seed      = seed;
+    _score     = 0;
+    _size      = 0;
+    _higher    = 0;
+    _closed    = false;
+    _truncated = false;
+
+}
+
+void MoveLog::resume(uint32_t const seed) {
+
+    // The moves played before the game was saved are unknown, so the session
+    // can no longer be replayed from the seed.
+    begin(seed);
+
+    _truncated = true;
+
+}
+
+bool MoveLog::record(Direction const d) {
+
+    if (_size >= MOVE_LOG_CAPACITY << 2 || _size == UINT16_MAX) {
+        _truncated = true;
+        return false;
+    }
+
+    uint8_t &b = _data[_size >> 2];
+    uint8_t  s = (_size & 3) << 1;
+
+    b = (b & ~(3 << s)) | (static_cast<uint8_t>(d) << s);
+
+    _size++;
+
+    return true;
+
+}
+
+bool MoveLog::undo() {
+
+    // Once truncated, the log no longer matches the moves actually played.
+    if (_truncated || _size == 0) return false;
+
+    _size--;
+    _closed = false;
+
+    return true;
+
+}
+
+void MoveLog::close(uint32_t const score, uint8_t const higher) {
+
+    _score  = score;
+    _higher = higher;
+    _closed = true;
+
+}
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,80 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   MoveLog.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Compact record of a game session
+ *
+ * @note A session is fully determined by the state of the generator when it
+ *       starts and by the sequence of moves, each of which fits on 2 bits and
+ *       is packed four per byte. The final score and highest tile are kept
+ *       as well, so that a replay can be checked against the original game.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "Board.h"
+
+#ifndef MOVE_LOG_CAPACITY
+#define MOVE_LOG_CAPACITY 1024 // bytes, that is 4096 moves
+#endif
+
+class MoveLog {
+
+    public:
+
+        void begin(uint32_t const seed);
+        void resume(uint32_t const seed);
+        bool record(Direction const d);
+        bool undo();
+        void close(uint32_t const score, uint8_t const higher);
+
+        uint32_t seed()      const { return _seed;   }
+        uint32_t score()     const { return _score;  }
+        uint8_t  higher()    const { return _higher; }
+        uint16_t size()      const { return _size;   }
+        bool     closed()    const { return _closed; }
+        bool     truncated() const { return _truncated; }
+
+        uint8_t const *data() const { return _data; }
+
+        Direction move(uint16_t const k) const { return move(_data, k); }
+
+        static Direction move(uint8_t const *data, uint16_t const k) {
+            return static_cast<Direction>((data[k >> 2] >> ((k & 3) << 1)) & 3);
+        }
+
+    private:
+
+        uint8_t  _data[MOVE_LOG_CAPACITY];
+        uint32_t _seed;
+        uint32_t _score;
+        uint16_t _size;
+        uint8_t  _higher;
+        bool     _closed;
+        bool     _truncated;
+
+};
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
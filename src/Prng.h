@@ -0,0 +1,64 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Prng.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Seedable pseudo-random number generator
+ *
+ * @note A Mulberry32 generator: its whole state is a single 32-bit word, so
+ *       that the state at the beginning of a game is enough to replay it.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+class Prng {
+
+    public:
+
+        Prng(uint32_t const seed = 0) : _state(seed) {}
+
+        void     seed(uint32_t const seed) { _state = seed; }
+        uint32_t state() const { return _state; }
+
+        uint32_t next() {
+
+            uint32_t z = _state += 0x6d2b79f5;
+            z = (z ^ (z >> 15)) * (z | 1);
+            z ^= z + (z ^ (z >> 7)) * (z | 61);
+
+            return z ^ (z >> 14);
+
+        }
+
+        // Uniform draw in [0, n), without any division.
+        uint32_t below(uint32_t const n) { return ((uint64_t)next() * n) >> 32; }
+
+    private:
+
+        uint32_t _state;
+
+};
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
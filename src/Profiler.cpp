@@ -0,0 +1,90 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Profiler.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Per-state and per-stage frame profiler
+ * -----------------------------------------------------------------------------
+ */
+
+#include "Profiler.h"
+
+#ifdef PROFILE
+
+#include <algorithm>
+
+uint32_t Profiler::_cycles[PROFILE_SAMPLES];
+uint8_t  Profiler::_tags[PROFILE_SAMPLES];
+uint16_t Profiler::_head = 0;
+uint16_t Profiler::_size = 0;
+
+void Profiler::record(uint8_t const tag, uint32_t const cycles) {
+
+    _cycles[_head] = cycles;
+    _tags[_head]   = tag;
+
+    _head = (_head + 1) % PROFILE_SAMPLES;
+    if (_size < PROFILE_SAMPLES) _size++;
+
+}
+
+void Profiler::dump(char const * const states[], uint8_t const count) {
+
+    static char const * const STAGES[] = { "frame", "input", "logic", "animate", "paint", "push", "hint" };
+
+    // The percentiles need the samples of a group side by side, which is
+    // only worth a temporary buffer when someone actually asks for them.
+    uint32_t *group = new uint32_t[_size];
+
+    Serial.printf("profile    %u samples, in cycles at 80 MHz\n", (unsigned)_size);
+    Serial.printf("state      stage      count        min        avg        p99\n");
+
+    for (uint8_t s = 0; s < count; ++s) {
+        for (uint8_t g = 0; g < static_cast<uint8_t>(Stage::COUNT); ++g) {
+
+            uint8_t  tag = (s << 3) | g;
+            uint16_t n   = 0;
+            uint64_t sum = 0;
+
+            for (uint16_t k = 0; k < _size; ++k) {
+                if (_tags[k] == tag) { group[n++] = _cycles[k]; sum += _cycles[k]; }
+            }
+
+            if (n == 0) continue;
+
+            uint16_t p99 = n - 1 - n / 100;
+            std::nth_element(group, group + p99, group + n);
+            uint32_t top = group[p99];
+            uint32_t low = *std::min_element(group, group + n);
+
+            Serial.printf("%-10s %-10s %5u %10u %10u %10u\n", states[s], STAGES[g], (unsigned)n, (unsigned)low, (unsigned)(sum / n), (unsigned)top);
+
+        }
+    }
+
+    delete[] group;
+
+}
+
+#endif
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
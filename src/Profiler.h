@@ -0,0 +1,99 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Profiler.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Per-state and per-stage frame profiler
+ *
+ * @note Only built with `-DPROFILE`: otherwise `PROFILE_SCOPE()` expands to
+ *       nothing and the game carries no instrumentation at all.
+ *
+ *       Every scope measures its duration with `ESP.getCycleCount()` and
+ *       stores it in a fixed ring buffer, tagged with the game state it
+ *       started in and its stage. The last `PROFILE_SAMPLES` samples are
+ *       then summed up on demand as min, average and 99th percentile.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#ifdef PROFILE
+
+#include <Arduino.h>
+
+#ifndef PROFILE_SAMPLES
+#define PROFILE_SAMPLES 512
+#endif
+
+#define PROFILE_SCOPE(stage) Profiler::Scope _profile_##stage(static_cast<uint8_t>(_state), Profiler::Stage::stage)
+
+class Profiler {
+
+    public:
+
+        enum class Stage : uint8_t {
+            FRAME,   // the whole loop iteration
+            INPUT,   // button polling
+            LOGIC,   // state update, tile moves included
+            ANIMATE, // interpolation snapshots and dirty areas
+            PAINT,   // composition of a band into the frame buffer
+            PUSH,    // transfer of a band to the display
+            HINT,    // slice of the hint search
+            COUNT
+        };
+
+        class Scope {
+
+            public:
+
+                Scope(uint8_t const state, Stage const stage)
+                : _tag((state << 3) | static_cast<uint8_t>(stage))
+                , _start(ESP.getCycleCount()) {}
+
+                ~Scope() { Profiler::record(_tag, ESP.getCycleCount() - _start); }
+
+            private:
+
+                uint8_t  _tag;
+                uint32_t _start;
+
+        };
+
+        static void record(uint8_t const tag, uint32_t const cycles);
+        static void dump(char const * const states[], uint8_t const count);
+
+    private:
+
+        static uint32_t _cycles[PROFILE_SAMPLES];
+        static uint8_t  _tags[PROFILE_SAMPLES];
+        static uint16_t _head;
+        static uint16_t _size;
+
+};
+
+#else
+
+#define PROFILE_SCOPE(stage)
+
+#endif
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,131 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Rect.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Screen rectangle and set of dirty areas
+ *
+ * @note The dirty areas are kept as a few disjoint rectangles rather than a
+ *       single bounding box, so that two small changes at opposite corners
+ *       of the board do not have the whole area between them repainted and
+ *       pushed. Overlapping areas are merged as they are added, and once the
+ *       set is full, a new area is merged with the one it grows the least.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#ifndef DIRTY_RECTS
+#define DIRTY_RECTS 4
+#endif
+
+struct Rect {
+
+    int16_t x = 0;
+    int16_t y = 0;
+    int16_t w = 0;
+    int16_t h = 0;
+
+    Rect() {}
+    Rect(int16_t const x, int16_t const y, int16_t const w, int16_t const h) : x(x), y(y), w(w), h(h) {}
+
+    bool empty() const { return w <= 0 || h <= 0; }
+
+    int32_t area() const { return empty() ? 0 : (int32_t)w * h; }
+
+    bool operator==(Rect const &r) const { return x == r.x && y == r.y && w == r.w && h == r.h; }
+    bool operator!=(Rect const &r) const { return !(*this == r); }
+
+    bool intersects(Rect const &r) const {
+        return !empty() && !r.empty() && x < r.x + r.w && r.x < x + w && y < r.y + r.h && r.y < y + h;
+    }
+
+    void add(Rect const &r) {
+
+        if (r.empty()) return;
+        if (empty()) { *this = r; return; }
+
+        int16_t right  = max(x + w, r.x + r.w);
+        int16_t bottom = max(y + h, r.y + r.h);
+
+        x = min(x, r.x);
+        y = min(y, r.y);
+        w = right  - x;
+        h = bottom - y;
+
+    }
+
+};
+
+class DirtyRects {
+
+    public:
+
+        DirtyRects() {}
+        DirtyRects(Rect const &r) { add(r); }
+
+        void clear() { _size = 0; }
+
+        void add(Rect r) {
+
+            if (r.empty()) return;
+
+            // Whatever overlaps the new area is absorbed into it, so that no
+            // pixel is ever painted twice.
+            for (uint8_t k = 0; k < _size;) {
+                if (_rects[k].intersects(r)) { r.add(_rects[k]); _rects[k] = _rects[--_size]; k = 0; }
+                else k++;
+            }
+
+            if (_size < DIRTY_RECTS) { _rects[_size++] = r; return; }
+
+            uint8_t best = 0;
+            int32_t cost = INT32_MAX;
+            for (uint8_t k = 0; k < _size; ++k) {
+                Rect u = _rects[k];
+                u.add(r);
+                int32_t c = u.area() - _rects[k].area();
+                if (c < cost) { cost = c; best = k; }
+            }
+
+            // The merged area may now overlap others, so it is added anew.
+            r.add(_rects[best]);
+            _rects[best] = _rects[--_size];
+            add(r);
+
+        }
+
+        uint8_t size() const { return _size; }
+
+        Rect const *begin() const { return _rects; }
+        Rect const *end()   const { return _rects + _size; }
+
+    private:
+
+        Rect    _rects[DIRTY_RECTS];
+        uint8_t _size = 0;
+
+};
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -1,43 +1,42 @@
 /**
  * -----------------------------------------------------------------------------
- * @file   Tile.h
+ * @file   Ticker.cpp
  * @author Stéphane Calderoni (https://github.com/m1cr0lab)
- * @brief  Tile handler
+ * @brief  Fixed timestep scheduler
  * -----------------------------------------------------------------------------
  */
 
-#pragma once
+#include "Ticker.h"
 
-#include <ESPboy.h>
+void Ticker::begin(uint32_t const period) {
 
-class Tile {
+    _period     = period;
+    _last       = micros();
+    _lag        = 0;
+    _frame_time = 0;
+    _dropped    = 0;
 
-    public:
+}
 
-        uint8_t pow2;
-        uint8_t x;
-        uint8_t y;
-        bool    arising;
-        bool    sliding;
-        bool    collapsing;
-        Tile   *collapser;
+uint8_t Ticker::due() {
 
-        Tile(uint8_t const i, uint8_t const j);
+    uint32_t now = micros();
 
-        void init(uint8_t const i, uint8_t const j);
-        void arise();
-        void slide(uint8_t const i, uint8_t const j);
-        void collapse();
-        void draw(LGFX_Sprite * const fb);
-    
-    private:
+    _frame_time = now - _last;
+    _lag       += _frame_time;
+    _last       = now;
 
-        uint8_t _scale;
+    uint32_t ticks = _lag / _period;
+    _lag          -= ticks * _period;
 
-        void _draw(LGFX_Sprite * const fb, uint8_t const x, uint8_t const y);
-        void _drawScaling(LGFX_Sprite * const fb);
+    if (ticks > _MAX_CATCH_UP) {
+        _dropped += ticks - _MAX_CATCH_UP;
+        ticks     = _MAX_CATCH_UP;
+    }
 
-};
+    return ticks;
+
+}
 
 /**
  * -----------------------------------------------------------------------------
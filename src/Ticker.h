@@ -0,0 +1,61 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Ticker.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Fixed timestep scheduler
+ *
+ * @note The game logic advances by fixed ticks whatever the rendering cost,
+ *       while each rendered frame knows how far it stands between the last
+ *       two ticks. When the loop falls too far behind, the late ticks are
+ *       dropped rather than replayed in a burst.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+class Ticker {
+
+    public:
+
+        void    begin(uint32_t const period);
+        uint8_t due();
+
+        uint16_t alpha()     const { return (_lag << 8) / _period; }
+        uint32_t frameTime() const { return _frame_time; }
+        uint32_t dropped()   const { return _dropped; }
+
+    private:
+
+        static uint8_t constexpr _MAX_CATCH_UP = 4;
+
+        uint32_t _period;
+        uint32_t _last;
+        uint32_t _lag;
+        uint32_t _frame_time;
+        uint32_t _dropped;
+
+};
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
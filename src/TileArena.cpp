@@ -0,0 +1,425 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   TileArena.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Statically allocated tile storage
+ * -----------------------------------------------------------------------------
+ */
+
+#include "TileArena.h"
+#include "TileAtlas.h"
+#include "ZoomCache.h"
+#include "assets.h"
+#include "Blitter.h"
+
+namespace {
+
+    // Screen layout of an NxN board: the 4x4 one matches the tile bitmaps.
+    template <uint8_t N>
+    struct Layout {
+        static uint8_t constexpr GAP    = N <= 4 ? 4 : (N <= 6 ? 3 : 2);
+        static uint8_t constexpr CELL   = (TFT_WIDTH - (N + 1) * GAP) / N;
+        static uint8_t constexpr MARGIN = (TFT_WIDTH - N * CELL - (N + 1) * GAP) >> 1;
+        static uint8_t constexpr ZOOM   = (200 * CELL + TILE_SIZE) / (TILE_SIZE << 1);
+    };
+
+}
+
+template <uint8_t N>
+LGFX_Sprite TileArena<N>::_scratch;
+
+template <uint8_t N>
+void TileArena<N>::begin() {
+
+    // The scratch tile and the caches are set up once and for all.
+    if (_scratch.getBuffer() != nullptr) return;
+
+    _scratch.createSprite(TILE_SIZE, TILE_SIZE);
+    _scratch.setColorDepth(8);
+    _scratch.createPalette();
+
+    TileAtlas::begin();
+    ZoomCache::begin();
+
+}
+
+template <uint8_t N>
+Rect TileArena<N>::cell(uint8_t const i, uint8_t const j) {
+
+    return Rect(_left(j), _top(i), Layout<N>::CELL, Layout<N>::CELL);
+
+}
+
+template <uint8_t N>
+void TileArena<N>::drawCell(LGFX_Sprite * const fb, uint8_t const i, uint8_t const j, int16_t const oy) {
+
+    _tile(fb, 0, _left(j), _top(i) - oy);
+
+}
+
+template <uint8_t N>
+void TileArena<N>::clear() {
+
+    _live = 0;
+
+}
+
+template <uint8_t N>
+typename TileArena<N>::Handle TileArena<N>::spawn(uint8_t const i, uint8_t const j, uint8_t const p) {
+
+    if (_live == (Mask)(((Mask)1 << (CAPACITY - 1) << 1) - 1)) return NONE;
+
+    Handle h = __builtin_ctzll((Mask)~_live);
+    _live   |= (Mask)1 << h;
+
+    pow2[h]      = p;
+    x[h]         = _tx[h] = _x0[h] = _rx[h] = _left(j);
+    y[h]         = _ty[h] = _y0[h] = _ry[h] = _top(i);
+    flags[h]     = ARISING;
+    collapser[h] = NONE;
+    _scale[h]    = 50;
+    _drawn[h]    = Rect();
+
+    return h;
+
+}
+
+template <uint8_t N>
+typename TileArena<N>::Handle TileArena<N>::place(uint8_t const i, uint8_t const j, uint8_t const p) {
+
+    // Same as a spawned tile, but already at rest.
+    Handle h = spawn(i, j, p);
+
+    if (h != NONE) {
+        flags[h]  = 0;
+        _scale[h] = 100;
+    }
+
+    return h;
+
+}
+
+template <uint8_t N>
+void TileArena<N>::release(Handle const h) {
+
+    _live &= ~((Mask)1 << h);
+
+}
+
+template <uint8_t N>
+void TileArena<N>::slideTo(Handle const h, uint8_t const i, uint8_t const j) {
+
+    _tx[h]    = _left(j);
+    _ty[h]    = _top(i);
+    flags[h] |= SLIDING;
+
+}
+
+template <uint8_t N>
+void TileArena<N>::merge(Handle const h, Handle const other, uint8_t const i, uint8_t const j) {
+
+    // The absorbed tile is given back to the arena right away, but its
+    // storage stays untouched until the merge animation is over since no
+    // tile is ever spawned in the meantime: a move cutting the animation
+    // short settles every tile first. Whatever the absorbed tile covered on
+    // screen is now up to the merged tile to repaint.
+    release(other);
+    _drawn[h].add(_drawn[other]);
+
+    pow2[h]++;
+    collapser[h] = other;
+    flags[h]    |= COLLAPSING;
+
+    slideTo(h, i, j);
+
+}
+
+template <uint8_t N>
+void TileArena<N>::arise(Handle const h) {
+
+    uint8_t ds = 100 - _scale[h];
+
+    if (ds < 4) {
+        flags[h] &= ~ARISING;
+        _scale[h] = 100;
+    } else {
+        _scale[h] += ds >> 1;
+    }
+
+}
+
+template <uint8_t N>
+void TileArena<N>::slide(Handle const h) {
+
+    uint8_t tx = _tx[h];
+    uint8_t ty = _ty[h];
+
+    if (collapsing(h)) {
+
+        Handle   c = collapser[h];
+        int8_t  dx = tx - x[c];
+        int8_t  dy = ty - y[c];
+        uint16_t d = dx * dx + dy * dy;
+
+        if (d < 4) {
+            x[c]      = tx;
+            y[c]      = ty;
+            _scale[h] = 150;
+            flags[h] &= ~SLIDING;
+        } else {
+            x[c] += dx >> 1;
+            y[c] += dy >> 1;
+        }
+
+    }
+
+    int8_t  dx = tx - x[h];
+    int8_t  dy = ty - y[h];
+    uint16_t d = dx * dx + dy * dy;
+
+    if (d < 4) {
+        x[h]      = tx;
+        y[h]      = ty;
+        _scale[h] = 150;
+        if (!collapsing(h)) flags[h] &= ~SLIDING;
+    } else {
+        x[h] += dx >> 1;
+        y[h] += dy >> 1;
+    }
+
+}
+
+template <uint8_t N>
+void TileArena<N>::collapse(Handle const h) {
+
+    uint8_t ds = _scale[h] - 100;
+
+    if (ds < 4) {
+        flags[h]    &= ~COLLAPSING;
+        collapser[h] = NONE;
+        _scale[h]    = 100;
+    } else {
+        _scale[h] -= ds >> 1;
+    }
+
+}
+
+template <uint8_t N>
+void TileArena<N>::settle(Handle const h) {
+
+    // Jumps to the end of any ongoing animation. The collapser was given
+    // back to the arena on merge and is now forgotten for good, so its slot
+    // may be taken again by the next spawn.
+    x[h]         = _tx[h];
+    y[h]         = _ty[h];
+    flags[h]    &= ANIMATED;
+    collapser[h] = NONE;
+    _scale[h]    = 100;
+
+}
+
+template <uint8_t N>
+void TileArena<N>::draw(LGFX_Sprite * const fb, Handle const h, int16_t const oy) {
+
+    // The frame buffer may only hold the band of rows starting at `oy`.
+    uint8_t const half = Layout<N>::CELL >> 1;
+
+    if (scaling(h)) {
+        _zoomed(fb, pow2[h], _zoom(_scale[h]), _rx[h] + half, _ry[h] + half - oy);
+        return;
+    }
+
+    if (collapsing(h)) {
+        Handle c = collapser[h];
+        _tile(fb, _face(c), _rx[c], _ry[c] - oy);
+    }
+
+    _tile(fb, _face(h), _rx[h], _ry[h] - oy);
+
+}
+
+template <uint8_t N>
+void TileArena<N>::snapshot() {
+
+    for (Handle h = 0; h < CAPACITY; ++h) {
+        if (!(_live & ((Mask)1 << h))) continue;
+        _x0[h] = x[h];
+        _y0[h] = y[h];
+        Handle c = collapser[h];
+        if (c != NONE) { _x0[c] = x[c]; _y0[c] = y[c]; }
+    }
+
+}
+
+template <uint8_t N>
+void TileArena<N>::invalidate(DirtyRects &dirty, uint16_t const alpha) {
+
+    for (Handle h = 0; h < CAPACITY; ++h) {
+
+        if (!(_live & ((Mask)1 << h))) continue;
+
+        _place(h, alpha);
+        if (collapser[h] != NONE) _place(collapser[h], alpha);
+
+        bool animated = flags[h] & (ARISING | SLIDING | COLLAPSING);
+        Rect now      = bounds(h);
+
+        // The area covered on the previous frame must be repainted as well.
+        if (animated || (flags[h] & ANIMATED) || now != _drawn[h]) {
+            dirty.add(_drawn[h]);
+            dirty.add(now);
+        }
+
+        _drawn[h] = now;
+
+        if (animated) flags[h] |= ANIMATED; else flags[h] &= ~ANIMATED;
+
+    }
+
+}
+
+template <uint8_t N>
+Rect TileArena<N>::bounds(Handle const h) const {
+
+    if (scaling(h)) return _box(_rx[h], _ry[h], _scale[h]);
+
+    Rect r = _box(_rx[h], _ry[h], 100);
+    if (collapsing(h)) r.add(_box(_rx[collapser[h]], _ry[collapser[h]], 100));
+
+    return r;
+
+}
+
+template <uint8_t N>
+uint8_t TileArena<N>::_left(uint8_t const j) {
+
+    return Layout<N>::MARGIN + Layout<N>::GAP + j * (Layout<N>::CELL + Layout<N>::GAP);
+
+}
+
+template <uint8_t N>
+uint8_t TileArena<N>::_top(uint8_t const i) {
+
+    return _left(i);
+
+}
+
+template <uint8_t N>
+uint8_t TileArena<N>::_zoom(uint8_t const scale) {
+
+    // Tile scales are relative to the cell, zooms to the tile bitmaps.
+    return Layout<N>::ZOOM == 100 ? scale : (scale * Layout<N>::ZOOM + 50) / 100;
+
+}
+
+template <uint8_t N>
+Rect TileArena<N>::_box(uint8_t const x, uint8_t const y, uint8_t const scale) {
+
+    uint8_t zoom = _zoom(scale);
+
+    if (zoom == 100) return Rect(x, y, TILE_SIZE, TILE_SIZE);
+
+    int16_t half = (TILE_SIZE * zoom + 199) / 200 + 1;
+    int16_t cx   = x + (Layout<N>::CELL >> 1);
+    int16_t cy   = y + (Layout<N>::CELL >> 1);
+
+    return Rect(cx - half, cy - half, half << 1, half << 1);
+
+}
+
+template <uint8_t N>
+void TileArena<N>::_place(Handle const h, uint16_t const alpha) {
+
+    // Positions are blended between the last two ticks, whereas the scale
+    // keeps to the steps the zoom cache is keyed on.
+    _rx[h] = _x0[h] + (((int16_t)x[h] - _x0[h]) * alpha >> 8);
+    _ry[h] = _y0[h] + (((int16_t)y[h] - _y0[h]) * alpha >> 8);
+
+}
+
+template <uint8_t N>
+void TileArena<N>::_tile(LGFX_Sprite * const fb, uint8_t const p, int16_t const x, int16_t const y) {
+
+    if (Layout<N>::ZOOM == 100) _glyph(fb, p, x, y);
+    else _zoomed(fb, p, Layout<N>::ZOOM, x + (Layout<N>::CELL >> 1), y + (Layout<N>::CELL >> 1));
+
+}
+
+template <uint8_t N>
+void TileArena<N>::_glyph(LGFX_Sprite * const fb, uint8_t const p, int16_t const x, int16_t const y) {
+
+    // Empty cells only make up the background, which is painted once.
+    if (p == 0) { _bitmap(fb, p, x, y); return; }
+
+    TileAtlas::Glyph const *g = TileAtlas::find(p);
+    if (g != nullptr) { TileAtlas::blit(fb, g, x, y); return; }
+
+    _bitmap(&_scratch, p, 0, 0);
+
+    if ((g = TileAtlas::insert(p, _scratch)) != nullptr) TileAtlas::blit(fb, g, x, y);
+    else _bitmap(fb, p, x, y);
+
+}
+
+template <uint8_t N>
+void TileArena<N>::_zoomed(LGFX_Sprite * const fb, uint8_t const p, uint8_t const zoom, int16_t const cx, int16_t const cy) {
+
+    ZoomCache::Frame const *f = ZoomCache::find(p, zoom);
+    if (f != nullptr) { ZoomCache::blit(fb, f, cx, cy); return; }
+
+    _scratch.clear(ZoomCache::TRANSPARENT);
+
+    _bitmap(&_scratch, p, 0, 0);
+
+    if ((f = ZoomCache::insert(p, zoom, _scratch)) != nullptr) ZoomCache::blit(fb, f, cx, cy);
+    else Blitter::zoomed(fb, _scratch, zoom, cx, cy, ZoomCache::TRANSPARENT);
+
+}
+
+template <uint8_t N>
+void TileArena<N>::_bitmap(LGFX_Sprite * const fb, uint8_t const p, int16_t const x, int16_t const y) {
+
+    Blitter::spans(
+        fb,
+        x,
+        y,
+        TILE,
+        p
+    );
+
+    if (p == 0) return;
+
+    Blitter::trimmed(
+        fb,
+        x + 2,
+        y + 5,
+        POWER_OF_TWO_WIDTH,
+        POWER_OF_TWO + pgm_read_word(POWER_OF_TWO_OFFSET + p - 1),
+        p < 3 ? 19 : 20
+    );
+
+}
+
+template class TileArena<BOARD_SIZE>;
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
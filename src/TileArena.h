@@ -0,0 +1,125 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   TileArena.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Statically allocated tile storage
+ *
+ * @note Tiles are laid out as a struct of arrays and addressed by 8-bit
+ *       handles, so that spawning and merging never touch the heap and the
+ *       animation passes walk contiguous memory.
+ *
+ *       The cells are laid out on screen according to the board size. The
+ *       tile bitmaps are drawn as is on the 4x4 board only, through the tile
+ *       atlas, and zoomed to the cell size on the other ones.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <ESPboy.h>
+#include "Board.h"
+#include "Rect.h"
+
+template <uint8_t N>
+class TileArena {
+
+    public:
+
+        typedef uint8_t Handle;
+        typedef typename Board<N>::Mask Mask;
+
+        static uint8_t constexpr CAPACITY = N * N;
+        static Handle  constexpr NONE     = 0xff;
+
+        enum Flag : uint8_t {
+            ARISING    = 1 << 0,
+            SLIDING    = 1 << 1,
+            COLLAPSING = 1 << 2,
+            ANIMATED   = 1 << 3 // animated on the previous frame
+        };
+
+        uint8_t pow2[CAPACITY];
+        uint8_t x[CAPACITY];
+        uint8_t y[CAPACITY];
+        uint8_t flags[CAPACITY];
+        Handle  collapser[CAPACITY];
+
+        static void begin();
+        static Rect cell(uint8_t const i, uint8_t const j);
+        static void drawCell(LGFX_Sprite * const fb, uint8_t const i, uint8_t const j, int16_t const oy);
+
+        void   clear();
+        Handle spawn(uint8_t const i, uint8_t const j, uint8_t const pow2);
+        Handle place(uint8_t const i, uint8_t const j, uint8_t const pow2);
+        void   release(Handle const h);
+
+        Mask live() const { return _live; }
+
+        bool arising(Handle const h)    const { return flags[h] & ARISING;    }
+        bool sliding(Handle const h)    const { return flags[h] & SLIDING;    }
+        bool collapsing(Handle const h) const { return flags[h] & COLLAPSING; }
+        bool scaling(Handle const h)    const { return arising(h) || (collapsing(h) && !sliding(h)); }
+
+        void slideTo(Handle const h, uint8_t const i, uint8_t const j);
+        void merge(Handle const h, Handle const other, uint8_t const i, uint8_t const j);
+
+        void arise(Handle const h);
+        void slide(Handle const h);
+        void collapse(Handle const h);
+        void settle(Handle const h);
+        void draw(LGFX_Sprite * const fb, Handle const h, int16_t const oy);
+
+        void snapshot();
+        void invalidate(DirtyRects &dirty, uint16_t const alpha);
+        Rect bounds(Handle const h) const;
+
+    private:
+
+        Mask _live;
+
+        uint8_t _scale[CAPACITY];
+        uint8_t _tx[CAPACITY], _ty[CAPACITY];
+        uint8_t _x0[CAPACITY], _y0[CAPACITY];
+        uint8_t _rx[CAPACITY], _ry[CAPACITY];
+        Rect    _drawn[CAPACITY];
+
+        // Tiles missing from the caches are composed in there.
+        static LGFX_Sprite _scratch;
+
+        static uint8_t _left(uint8_t const j);
+        static uint8_t _top(uint8_t const i);
+        static uint8_t _zoom(uint8_t const scale);
+        static Rect    _box(uint8_t const x, uint8_t const y, uint8_t const scale);
+
+        static void _bitmap(LGFX_Sprite * const fb, uint8_t const p, int16_t const x, int16_t const y);
+        static void _tile(LGFX_Sprite * const fb, uint8_t const p, int16_t const x, int16_t const y);
+        static void _glyph(LGFX_Sprite * const fb, uint8_t const p, int16_t const x, int16_t const y);
+        static void _zoomed(LGFX_Sprite * const fb, uint8_t const p, uint8_t const zoom, int16_t const cx, int16_t const cy);
+
+        uint8_t _face(Handle const h) const { return sliding(h) && collapsing(h) ? pow2[h] - 1 : pow2[h]; }
+
+        void _place(Handle const h, uint16_t const alpha);
+
+};
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
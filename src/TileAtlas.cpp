@@ -0,0 +1,147 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   TileAtlas.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Atlas of ready-made tile images
+ * -----------------------------------------------------------------------------
+ */
+
+#include "TileAtlas.h"
+
+TileAtlas::Glyph TileAtlas::_glyphs[_SLOTS ? _SLOTS : 1];
+uint8_t         *TileAtlas::_pool  = nullptr;
+uint32_t         TileAtlas::_clock = 0;
+TileAtlas::Stats TileAtlas::_stats = {};
+
+void TileAtlas::begin() {
+
+    // Carved once and never given back.
+    if (_pool == nullptr && _SLOTS > 0) _pool = (uint8_t*)malloc(_SLOTS * _BYTES);
+
+}
+
+TileAtlas::Glyph const *TileAtlas::find(uint8_t const pow2) {
+
+    for (Glyph &g : _glyphs) {
+        if (g.pixels != nullptr && g.pow2 == pow2) {
+            g.used = ++_clock;
+            _stats.hits++;
+            return &g;
+        }
+    }
+
+    _stats.misses++;
+
+    return nullptr;
+
+}
+
+TileAtlas::Glyph const *TileAtlas::insert(uint8_t const pow2, LGFX_Sprite &tile) {
+
+    if (_pool == nullptr) return nullptr;
+
+    // Picks a free slot, or the least recently used one. Each slot owns its
+    // block of the pool, so the glyph goes straight in there.
+    Glyph *slot = nullptr;
+    Glyph *lru  = nullptr;
+
+    for (Glyph &g : _glyphs) {
+        if (g.pixels == nullptr) { if (slot == nullptr) slot = &g; }
+        else if (lru == nullptr || g.used < lru->used) lru = &g;
+    }
+
+    if (slot == nullptr) {
+
+        // Glyphs drawn in the last frames are about to be drawn again.
+        if (_clock - lru->used < _PINNED) return nullptr;
+
+        _evict(*lru);
+        _stats.evictions++;
+
+        slot = lru;
+
+    }
+
+    uint8_t *pixels = _pool + (slot - _glyphs) * _BYTES;
+
+    memcpy(pixels, tile.getBuffer(), _BYTES);
+
+    slot->pow2   = pow2;
+    slot->used   = ++_clock;
+    slot->pixels = pixels;
+
+    _stats.glyphs++;
+    _stats.bytes += _BYTES;
+    if (_stats.bytes > _stats.peak) _stats.peak = _stats.bytes;
+
+    return slot;
+
+}
+
+void TileAtlas::blit(LGFX_Sprite * const fb, Glyph const * const g, int16_t const x, int16_t const y) {
+
+    int32_t cl, ct, cw, ch;
+    fb->getClipRect(&cl, &ct, &cw, &ch);
+
+    uint8_t *dst = (uint8_t*)fb->getBuffer();
+    int16_t  w   = fb->width();
+
+    // Only the spans of the tile shape are copied, the corners being left
+    // as they are, and each of them is clipped on the way.
+    uint8_t const *data = TILE;
+    uint8_t        top  = pgm_read_byte(data++);
+    uint8_t        rows = pgm_read_byte(data++);
+
+    for (uint8_t j = 0; j < rows; ++j) {
+
+        uint8_t n  = pgm_read_byte(data++);
+        int16_t ty = y + top + j;
+        bool    in = ty >= ct && ty < ct + ch;
+
+        for (uint8_t k = 0; k < n; ++k) {
+
+            uint8_t sx  = pgm_read_byte(data++);
+            uint8_t len = pgm_read_byte(data++);
+
+            if (!in) continue;
+
+            int16_t left  = max<int16_t>(x + sx, cl);
+            int16_t right = min<int16_t>(x + sx + len, cl + cw);
+
+            if (left < right) memcpy(dst + ty * w + left, g->pixels + (top + j) * TILE_SIZE + (left - x), right - left);
+
+        }
+
+    }
+
+}
+
+void TileAtlas::_evict(Glyph &g) {
+
+    _stats.glyphs--;
+    _stats.bytes -= _BYTES;
+    g.pixels      = nullptr;
+
+}
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,96 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   TileAtlas.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Atlas of ready-made tile images
+ *
+ * @note A tile at rest is drawn in two passes, the tile shape and then its
+ *       label, both decoded from their 1-bit assets. The atlas keeps the
+ *       outcome as an 8-bit image, one glyph per tile value, built the first
+ *       time that value shows up. Drawing a tile is then a copy of each of
+ *       its rows, clipped to the spans of the tile shape, which leaves the
+ *       rounded corners untouched.
+ *
+ *       The glyphs live in a pool of `TILE_ATLAS_BUDGET` bytes, cut into as
+ *       many fixed blocks as it holds. It is carved once and for all when the
+ *       game frame buffer is set up, once the splash screen has given back
+ *       its own, so that the atlas never calls on the heap afterwards. The
+ *       glyphs are evicted in least recently used order when the pool is
+ *       full. When the ongoing frame needs more glyphs than the pool holds,
+ *       or when the pool could not be carved, the extra tiles are simply
+ *       decoded as before rather than thrashing the atlas.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <ESPboy.h>
+#include "assets.h"
+
+#ifndef TILE_ATLAS_BUDGET
+#define TILE_ATLAS_BUDGET 8192 // 11 glyphs
+#endif
+
+class TileAtlas {
+
+    public:
+
+        struct Glyph {
+            uint8_t  pow2;
+            uint32_t used;
+            uint8_t *pixels;
+        };
+
+        struct Stats {
+            uint32_t hits;
+            uint32_t misses;
+            uint32_t evictions;
+            uint16_t glyphs;
+            uint16_t bytes;
+            uint16_t peak;
+            float    hitRate() const { return hits + misses ? (float)hits / (hits + misses) : 0; }
+        };
+
+        static void         begin();
+        static Glyph const *find(uint8_t const pow2);
+        static Glyph const *insert(uint8_t const pow2, LGFX_Sprite &tile);
+        static void         blit(LGFX_Sprite * const fb, Glyph const * const g, int16_t const x, int16_t const y);
+
+        static Stats const &stats() { return _stats; }
+
+    private:
+
+        static uint8_t  constexpr _PINNED = 32; // draws, about two frames of tiles
+        static uint16_t constexpr _BYTES  = TILE_SIZE * TILE_SIZE;
+        static uint8_t  constexpr _SLOTS  = TILE_ATLAS_BUDGET / _BYTES < 16 ? TILE_ATLAS_BUDGET / _BYTES : 16;
+
+        static Glyph    _glyphs[_SLOTS ? _SLOTS : 1];
+        static uint8_t *_pool;
+        static uint32_t _clock;
+        static Stats    _stats;
+
+        static void _evict(Glyph &g);
+
+};
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
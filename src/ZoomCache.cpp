@@ -0,0 +1,155 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   ZoomCache.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Cache of pre-scaled tile frames
+ * -----------------------------------------------------------------------------
+ */
+
+#include "ZoomCache.h"
+#include "Blitter.h"
+#include "assets.h"
+
+ZoomCache::Frame ZoomCache::_frames[_SLOTS];
+uint8_t         *ZoomCache::_pool  = nullptr;
+uint32_t         ZoomCache::_bytes = 0;
+uint32_t         ZoomCache::_clock = 0;
+
+void ZoomCache::begin() {
+
+    // Carved once and never given back.
+    if (_pool == nullptr && ZOOM_CACHE_BUDGET > 0) _pool = (uint8_t*)malloc(ZOOM_CACHE_BUDGET);
+
+}
+
+ZoomCache::Frame const *ZoomCache::find(uint8_t const pow2, uint8_t const scale) {
+
+    for (Frame &f : _frames) {
+        if (f.pixels != nullptr && f.pow2 == pow2 && f.scale == scale) {
+            f.used = ++_clock;
+            return &f;
+        }
+    }
+
+    return nullptr;
+
+}
+
+ZoomCache::Frame const *ZoomCache::insert(uint8_t const pow2, uint8_t const scale, LGFX_Sprite &tile) {
+
+    uint8_t  size  = _size(scale);
+    uint16_t bytes = size * size;
+
+    if (_pool == nullptr || bytes > ZOOM_CACHE_BUDGET) return nullptr;
+
+    // Makes room for the new frame and picks a free slot.
+    Frame *slot = nullptr;
+    for (;;) {
+
+        Frame *lru = nullptr;
+        slot       = nullptr;
+
+        for (Frame &f : _frames) {
+            if (f.pixels == nullptr) { if (slot == nullptr) slot = &f; }
+            else if (lru == nullptr || f.used < lru->used) lru = &f;
+        }
+
+        if (slot != nullptr && _bytes + bytes <= ZOOM_CACHE_BUDGET) break;
+
+        // Frames used by the ongoing animations are never evicted: when they
+        // don't leave enough room, live zooming is cheaper than thrashing.
+        if (lru == nullptr || _clock - lru->used < _PINNED) return nullptr;
+
+        _evict(*lru);
+
+    }
+
+    // The new frame goes right after the others.
+    uint8_t *pixels = _pool + _bytes;
+
+    memset(pixels, TRANSPARENT, bytes);
+    Blitter::zoomed(pixels, size, tile, scale, TRANSPARENT);
+
+    slot->pow2   = pow2;
+    slot->scale  = scale;
+    slot->size   = size;
+    slot->used   = ++_clock;
+    slot->pixels = pixels;
+
+    _bytes += bytes;
+
+    return slot;
+
+}
+
+void ZoomCache::blit(LGFX_Sprite * const fb, Frame const * const f, int16_t const cx, int16_t const cy) {
+
+    int32_t cl, ct, cw, ch;
+    fb->getClipRect(&cl, &ct, &cw, &ch);
+
+    int16_t  x0  = cx - (f->size >> 1);
+    int16_t  y0  = cy - (f->size >> 1);
+    int16_t  w   = fb->width();
+    uint8_t *dst = (uint8_t*)fb->getBuffer();
+
+    int16_t top    = max<int16_t>(y0, ct);
+    int16_t bottom = min<int16_t>(y0 + f->size, ct + ch);
+    int16_t left   = max<int16_t>(x0, cl);
+    int16_t right  = min<int16_t>(x0 + f->size, cl + cw);
+
+    for (int16_t y = top; y < bottom; ++y) {
+        uint8_t const *src = f->pixels + (y - y0) * f->size;
+        uint8_t       *row = dst + y * w;
+        for (int16_t x = left; x < right; ++x) {
+            uint8_t c = src[x - x0];
+            if (c != TRANSPARENT) row[x] = c;
+        }
+    }
+
+}
+
+uint8_t ZoomCache::_size(uint8_t const scale) {
+
+    // Same conservative box as TileArena::bounds().
+    return ((TILE_SIZE * scale + 199) / 200 + 1) << 1;
+
+}
+
+void ZoomCache::_evict(Frame &f) {
+
+    uint16_t bytes = f.size * f.size;
+    uint8_t *end   = f.pixels + bytes;
+
+    // Slides the later frames down over the evicted one.
+    memmove(f.pixels, end, _pool + _bytes - end);
+
+    for (Frame &g : _frames) {
+        if (g.pixels != nullptr && g.pixels >= end) g.pixels -= bytes;
+    }
+
+    _bytes  -= bytes;
+    f.pixels = nullptr;
+
+}
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,85 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   ZoomCache.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Cache of pre-scaled tile frames
+ *
+ * @note Arising and collapsing tiles always go through the same sequences of
+ *       scales (50 -> 100 and 150 -> 100 by halving the gap), so each zoomed
+ *       frame only needs to be computed once. Frames are built on first use,
+ *       straight into a pool of `ZOOM_CACHE_BUDGET` bytes, and the least
+ *       recently used ones are evicted when it is full. The pool is carved
+ *       once and for all when the game frame buffer is set up, once the
+ *       splash screen has given back its own. The frames are kept packed at
+ *       the start of the pool, an eviction sliding the later ones down, so
+ *       the cache never calls on the heap afterwards nor fragments its own
+ *       pool. When no frame can be evicted, or when the pool could not be
+ *       carved, the caller simply falls back to live zooming. On boards other than 4x4, resting tiles are zoomed
+ *       to the cell size as well, and go through the very same cache.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <ESPboy.h>
+
+#ifndef ZOOM_CACHE_BUDGET
+#define ZOOM_CACHE_BUDGET 12288
+#endif
+
+class ZoomCache {
+
+    public:
+
+        // Palette index left out of the tile corners when blitting.
+        static uint8_t constexpr TRANSPARENT = 0xff;
+
+        struct Frame {
+            uint8_t  pow2;
+            uint8_t  scale;
+            uint8_t  size;
+            uint32_t used;
+            uint8_t *pixels;
+        };
+
+        static void         begin();
+        static Frame const *find(uint8_t const pow2, uint8_t const scale);
+        static Frame const *insert(uint8_t const pow2, uint8_t const scale, LGFX_Sprite &tile);
+        static void         blit(LGFX_Sprite * const fb, Frame const * const f, int16_t const cx, int16_t const cy);
+
+    private:
+
+        static uint8_t constexpr _SLOTS  = 32;
+        static uint8_t constexpr _PINNED = 64;
+
+        static Frame    _frames[_SLOTS];
+        static uint8_t *_pool;
+        static uint32_t _bytes;
+        static uint32_t _clock;
+
+        static uint8_t _size(uint8_t const scale);
+        static void    _evict(Frame &f);
+
+};
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,46 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   LatencyDisplay.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Display backend with a simulated bus (native environment only)
+ * -----------------------------------------------------------------------------
+ */
+
+#include "LatencyDisplay.h"
+
+void LatencyDisplay::push(LGFX_Sprite * const fb, Rect const &r, int16_t const oy) {
+
+    TftDisplay::push(fb, r, oy);
+
+    uint64_t ns = (uint64_t)r.w * r.h * _ns_per_pixel;
+
+    Clock::time_point done = Clock::now() + std::chrono::nanoseconds(ns);
+
+    // Spinning keeps the simulated bus accurate to the microsecond.
+    while (Clock::now() < done);
+
+    _sending += ns;
+
+}
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,59 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   LatencyDisplay.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Display backend with a simulated bus (native environment only)
+ *
+ * @note Pixels land on the panel stand-in as they do through the TFT backend,
+ *       and the push then spins for as long as the given cost per pixel says,
+ *       in real time, the way the ESP8266 waits for its SPI bus. The time
+ *       spent is accounted, which tells the share of the frame time that
+ *       goes to the display.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <chrono>
+#include "Display.h"
+
+class LatencyDisplay : public TftDisplay {
+
+    public:
+
+        LatencyDisplay(uint32_t const ns_per_pixel) : _ns_per_pixel(ns_per_pixel) {}
+
+        void push(LGFX_Sprite * const fb, Rect const &r, int16_t const oy) override;
+
+        double sending() const { return _sending * 1e-9; }
+
+    private:
+
+        typedef std::chrono::steady_clock Clock;
+
+        uint32_t _ns_per_pixel;
+        uint64_t _sending = 0;
+
+};
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,248 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Simulator.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Parallel Monte-Carlo game runner (native environment only)
+ * -----------------------------------------------------------------------------
+ */
+
+#include "Simulator.h"
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+// -----------------------------------------------------------------------------
+// Policies
+// -----------------------------------------------------------------------------
+
+uint8_t Simulator::_random(Grid const &, Grid const *, uint32_t const *, uint8_t const legal, Prng &rng) {
+
+    return Grid::select(legal, rng.below(__builtin_popcount(legal)));
+
+}
+
+uint8_t Simulator::_greedy(Grid const &, Grid const *, uint32_t const *gain, uint8_t const legal, Prng &rng) {
+
+    // Takes the biggest immediate gain, ties being broken at random.
+    uint32_t top  = 0;
+    uint8_t  best = 0;
+
+    for (uint8_t d = 0; d < 4; ++d) {
+        if (!(legal & (1 << d))) continue;
+        if (best == 0 || gain[d] > top) { top = gain[d]; best = 1 << d; }
+        else if (gain[d] == top) best |= 1 << d;
+    }
+
+    return Grid::select(best, rng.below(__builtin_popcount(best)));
+
+}
+
+uint8_t Simulator::_corner(Grid const &, Grid const *, uint32_t const *, uint8_t const legal, Prng &) {
+
+    // Keeps the big tiles in the lower left corner: up only as a last resort.
+    static Direction constexpr ORDER[] = { Direction::DOWN, Direction::LEFT, Direction::RIGHT, Direction::UP };
+
+    for (Direction d : ORDER) {
+        if (legal & (1 << static_cast<uint8_t>(d))) return static_cast<uint8_t>(d);
+    }
+
+    return 0;
+
+}
+
+Simulator::Policy Simulator::policy(char const * const name) {
+
+    if (strcmp(name, "random") == 0) return _random;
+    if (strcmp(name, "greedy") == 0) return _greedy;
+    if (strcmp(name, "corner") == 0) return _corner;
+
+    return nullptr;
+
+}
+
+// -----------------------------------------------------------------------------
+// Runner
+// -----------------------------------------------------------------------------
+
+Simulator::Report Simulator::run(Policy const policy, uint64_t const games, uint32_t const seed, uint8_t const threads) {
+
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now();
+
+    uint8_t n = threads ? threads : std::max(1U, std::thread::hardware_concurrency());
+
+    std::vector<Report>      reports(n);
+    std::vector<std::thread> workers;
+
+    for (uint8_t k = 0; k < n; ++k) {
+        uint64_t share  = games / n + (k < games % n ? 1 : 0);
+        uint32_t stream = Prng(seed ^ (k * 0x9e3779b9U)).next();
+        workers.emplace_back(_play, policy, share, stream, std::ref(reports[k]));
+    }
+
+    for (std::thread &w : workers) w.join();
+
+    Report r = reports[0];
+    for (uint8_t k = 1; k < n; ++k) r.merge(reports[k]);
+
+    r.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    return r;
+
+}
+
+void Simulator::_play(Policy const policy, uint64_t const games, uint32_t const seed, Report &r) {
+
+    r = Report();
+    r.tiles.resize(Grid::MAX_POW2 + 1);
+
+    Prng stream(seed);
+
+    for (uint64_t g = 0; g < games; ++g) {
+
+        // Every game gets a seed of its own, so that any of them can be
+        // replayed on its own.
+        Prng     rng(stream.next());
+        Grid     b;
+        Grid     next[4];
+        uint32_t gain[4];
+        uint32_t score = 0;
+        uint32_t moves = 0;
+        uint8_t  legal;
+
+        b.spawn(rng);
+        b.spawn(rng);
+
+        while ((legal = b.moves(next, gain))) {
+            uint8_t d = policy(b, next, gain, legal, rng);
+            score += gain[d];
+            b      = next[d];
+            b.spawn(rng);
+            moves++;
+        }
+
+        uint32_t sbin = score / Report::SCORE_BIN;
+        uint32_t mbin = moves / Report::MOVE_BIN;
+
+        if (sbin >= r.scores.size()) r.scores.resize(sbin + 1);
+        if (mbin >= r.turns.size())  r.turns.resize(mbin + 1);
+
+        r.scores[sbin]++;
+        r.turns[mbin]++;
+        r.tiles[b.highest()]++;
+
+        r.games++;
+        r.moves  += moves;
+        r.points += score;
+        r.best    = std::max(r.best, score);
+
+    }
+
+}
+
+// -----------------------------------------------------------------------------
+// Report
+// -----------------------------------------------------------------------------
+
+void Simulator::Report::merge(Report const &r) {
+
+    games  += r.games;
+    moves  += r.moves;
+    points += r.points;
+    best    = std::max(best, r.best);
+
+    if (scores.size() < r.scores.size()) scores.resize(r.scores.size());
+    if (turns.size()  < r.turns.size())  turns.resize(r.turns.size());
+
+    for (size_t k = 0; k < r.scores.size(); ++k) scores[k] += r.scores[k];
+    for (size_t k = 0; k < r.turns.size();  ++k) turns[k]  += r.turns[k];
+    for (size_t k = 0; k < r.tiles.size();  ++k) tiles[k]  += r.tiles[k];
+
+}
+
+uint32_t Simulator::Report::percentile(float const p) const {
+
+    uint64_t rank = p * games;
+    uint64_t seen = 0;
+
+    for (size_t k = 0; k < scores.size(); ++k) {
+        if ((seen += scores[k]) > rank) return k * SCORE_BIN;
+    }
+
+    return best;
+
+}
+
+static void histogram(char const * const title, std::vector<uint64_t> const &bins, uint16_t const width, uint64_t const total) {
+
+    // Adjacent bins are grouped so that the chart never exceeds 16 rows.
+    size_t last = bins.size();
+    while (last && bins[last - 1] == 0) last--;
+
+    size_t first = 0;
+    while (first < last && bins[first] == 0) first++;
+
+    size_t group = (last - first + 15) / 16;
+    if (group == 0) group = 1;
+
+    printf("%s\n", title);
+
+    for (size_t k = first; k < last; k += group) {
+
+        uint64_t count = 0;
+        for (size_t i = k; i < std::min(k + group, last); ++i) count += bins[i];
+
+        double share = total ? 100. * count / total : 0;
+        char   bar[41];
+        size_t len = share * .4 + .5;
+        memset(bar, '#', len);
+        bar[len] = 0;
+
+        printf("  %7zu - %-7zu %6.2f %% %s\n", k * width, std::min(k + group, last) * width - 1, share, bar);
+
+    }
+
+}
+
+void Simulator::Report::print() const {
+
+    printf("games         %llu in %.2f s, %.0f games/s, %.0f moves/s\n",
+        (unsigned long long)games, seconds, games / seconds, moves / seconds);
+
+    if (games == 0) return;
+
+    printf("score         mean %.0f, p10 %u, p50 %u, p90 %u, p99 %u, best %u\n",
+        (double)points / games, percentile(.1f), percentile(.5f), percentile(.9f), percentile(.99f), best);
+    printf("moves         mean %.1f per game\n", (double)moves / games);
+
+    printf("highest tile\n");
+    for (uint8_t p = 1; p < tiles.size(); ++p) {
+        if (tiles[p]) printf("  %7u         %6.2f %%\n", 1U << p, 100. * tiles[p] / games);
+    }
+
+    histogram("score distribution", scores, SCORE_BIN, games);
+    histogram("moves per game", turns, MOVE_BIN, games);
+
+}
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,85 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Simulator.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Parallel Monte-Carlo game runner (native environment only)
+ *
+ * @note Complete games are played through the very rules of the engine,
+ *       `Board::spawn()` and `Board::moves()` at the `BOARD_SIZE` the game is
+ *       built for, by a pluggable policy. Each thread owns its generator
+ *       stream and its statistics, which are only merged once all the games
+ *       are over, so that nothing is ever shared while playing.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <vector>
+#include "Board.h"
+
+class Simulator {
+
+    public:
+
+        typedef Board<BOARD_SIZE> Grid;
+
+        // Returns the direction to play among the `legal` ones, given the
+        // successors and score gains of the current board.
+        typedef uint8_t (*Policy)(Grid const &b, Grid const *next, uint32_t const *gain, uint8_t const legal, Prng &rng);
+
+        struct Report {
+
+            static uint16_t constexpr SCORE_BIN = 256;
+            static uint16_t constexpr MOVE_BIN  = 32;
+
+            uint64_t games   = 0;
+            uint64_t moves   = 0;
+            uint64_t points  = 0;
+            uint32_t best    = 0;
+            double   seconds = 0;
+
+            std::vector<uint64_t> scores; // by bins of SCORE_BIN points
+            std::vector<uint64_t> tiles;  // by exponent of the highest tile
+            std::vector<uint64_t> turns;  // by bins of MOVE_BIN moves
+
+            uint32_t percentile(float const p) const;
+            void     merge(Report const &r);
+            void     print() const;
+
+        };
+
+        static Policy policy(char const * const name);
+
+        static Report run(Policy const policy, uint64_t const games, uint32_t const seed, uint8_t const threads = 0);
+
+    private:
+
+        static uint8_t _random(Grid const &b, Grid const *next, uint32_t const *gain, uint8_t const legal, Prng &rng);
+        static uint8_t _greedy(Grid const &b, Grid const *next, uint32_t const *gain, uint8_t const legal, Prng &rng);
+        static uint8_t _corner(Grid const &b, Grid const *next, uint32_t const *gain, uint8_t const legal, Prng &rng);
+
+        static void _play(Policy const policy, uint64_t const games, uint32_t const seed, Report &r);
+
+};
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
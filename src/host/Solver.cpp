@@ -0,0 +1,353 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Solver.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Multi-threaded expectimax solver (native environment only)
+ * -----------------------------------------------------------------------------
+ */
+
+#include "Solver.h"
+#include <chrono>
+#include <cmath>
+
+// -----------------------------------------------------------------------------
+// Work-stealing task pool
+// -----------------------------------------------------------------------------
+
+TaskPool::TaskPool(uint8_t const threads)
+: _queues(threads ? threads : 1)
+, _pending(0)
+, _generation(0)
+, _stop(false) {
+
+    // The calling thread is the worker #0.
+    for (uint8_t id = 1; id < _queues.size(); ++id) _workers.emplace_back(&TaskPool::_work, this, id);
+
+}
+
+TaskPool::~TaskPool() {
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _stop = true;
+    }
+
+    _wake.notify_all();
+    for (std::thread &w : _workers) w.join();
+
+}
+
+void TaskPool::run(std::vector<Task> &tasks) {
+
+    if (tasks.empty()) return;
+
+    // The count is published before any task is queued: a worker still
+    // draining from the previous batch may run one of them at once.
+    _pending.fetch_add(tasks.size(), std::memory_order_release);
+
+    // Tasks are dealt round-robin, then each worker drains its own queue from
+    // the back and steals from the front of the others once it runs dry.
+    for (size_t k = 0; k < tasks.size(); ++k) {
+        Queue &q = _queues[k % _queues.size()];
+        std::lock_guard<std::mutex> guard(q.lock);
+        q.tasks.push_back(std::move(tasks[k]));
+    }
+
+    tasks.clear();
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _generation++;
+    }
+
+    _wake.notify_all();
+
+    _drain(0);
+
+    while (_pending.load(std::memory_order_acquire)) std::this_thread::yield();
+
+}
+
+void TaskPool::_work(uint8_t const id) {
+
+    uint32_t seen = 0;
+
+    for (;;) {
+
+        {
+            std::unique_lock<std::mutex> guard(_lock);
+            _wake.wait(guard, [&] { return _stop || _generation != seen; });
+            if (_stop) return;
+            seen = _generation;
+        }
+
+        _drain(id);
+
+    }
+
+}
+
+void TaskPool::_drain(uint8_t const id) {
+
+    Task task;
+    while (_pop(id, task)) {
+        task();
+        _pending.fetch_sub(1, std::memory_order_release);
+    }
+
+}
+
+bool TaskPool::_pop(uint8_t const id, Task &task) {
+
+    {
+        Queue &q = _queues[id];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (!q.tasks.empty()) {
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+            return true;
+        }
+    }
+
+    for (uint8_t k = 1; k < _queues.size(); ++k) {
+        Queue &q = _queues[(id + k) % _queues.size()];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (!q.tasks.empty()) {
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+
+}
+
+// -----------------------------------------------------------------------------
+// Expectimax
+// -----------------------------------------------------------------------------
+
+float Solver::_heuristic[0x10000];
+
+Solver::Solver(uint8_t const depth, uint8_t const threads)
+: _depth(depth ? depth : 1)
+, _pool(threads ? threads : std::max(1U, std::thread::hardware_concurrency()))
+, _table(1UL << _TT_BITS)
+, _nodes(0) {
+
+    static std::once_flag init;
+    std::call_once(init, _initHeuristic);
+
+    for (Entry &e : _table) { e.check = 0; e.data = 0; }
+
+}
+
+void Solver::_initHeuristic() {
+
+    // Row weights borrowed from the classic 2048 expectimax bots: empty cells,
+    // adjacent equal tiles and monotonic rows are rewarded, big scattered
+    // tiles are penalized.
+    for (uint32_t r = 0; r < 0x10000; ++r) {
+
+        uint8_t line[4];
+        for (uint8_t k = 0; k < 4; ++k) line[k] = (r >> (k << 2)) & 0xf;
+
+        float   sum    = 0;
+        uint8_t empty  = 0;
+        uint8_t merges = 0;
+        uint8_t prev   = 0;
+        uint8_t count  = 0;
+
+        for (uint8_t k = 0; k < 4; ++k) {
+            uint8_t p = line[k];
+            sum += powf(p, 3.5f);
+            if (p == 0) { empty++; continue; }
+            if (prev == p) count++;
+            else if (count > 0) { merges += 1 + count; count = 0; }
+            prev = p;
+        }
+        if (count > 0) merges += 1 + count;
+
+        float left  = 0;
+        float right = 0;
+        for (uint8_t k = 1; k < 4; ++k) {
+            float a = powf(line[k-1], 4);
+            float b = powf(line[k], 4);
+            if (line[k-1] > line[k]) left += a - b; else right += b - a;
+        }
+
+        _heuristic[r] = 200000.f + 270.f * empty + 700.f * merges - 47.f * std::min(left, right) - 11.f * sum;
+
+    }
+
+}
+
+float Solver::_evaluate(uint64_t const b) {
+
+    uint64_t t = Board<4>::transpose(b);
+    float    s = 0;
+
+    for (uint8_t k = 0; k < 64; k += 16) s += _heuristic[(b >> k) & 0xffff] + _heuristic[(t >> k) & 0xffff];
+
+    return s;
+
+}
+
+bool Solver::_probe(uint64_t const b, uint8_t const depth, float &score) {
+
+    Entry   &e = _table[(b * 0x9e3779b97f4a7c15ULL) >> (64 - _TT_BITS)];
+    uint64_t d = e.data.load(std::memory_order_relaxed);
+    uint64_t c = e.check.load(std::memory_order_relaxed);
+
+    // A torn write cannot pass the xor check, so no lock is ever needed.
+    if ((c ^ d) != b || (uint8_t)(d >> 32) < depth) return false;
+
+    uint32_t bits = d;
+    memcpy(&score, &bits, sizeof(score));
+
+    return true;
+
+}
+
+void Solver::_store(uint64_t const b, uint8_t const depth, float const score) {
+
+    Entry   &e = _table[(b * 0x9e3779b97f4a7c15ULL) >> (64 - _TT_BITS)];
+    uint32_t bits;
+    memcpy(&bits, &score, sizeof(bits));
+
+    uint64_t d = ((uint64_t)depth << 32) | bits;
+
+    e.data.store(d, std::memory_order_relaxed);
+    e.check.store(d ^ b, std::memory_order_relaxed);
+
+}
+
+float Solver::_max(uint64_t const b, uint8_t const depth, float const prob, uint64_t &nodes) {
+
+    nodes++;
+
+    Board<4> next[4];
+    uint8_t  legal = Board<4>(b).moves(next);
+
+    float best = 0;
+    for (uint8_t d = 0; d < 4; ++d) {
+        if (legal & (1 << d)) best = std::max(best, _chance(next[d].cells, depth - 1, prob, nodes));
+    }
+
+    return best;
+
+}
+
+float Solver::_chance(uint64_t const b, uint8_t const depth, float const prob, uint64_t &nodes) {
+
+    if (depth == 0 || prob < _PROB_CUTOFF) { nodes++; return _evaluate(b); }
+
+    float score;
+    if (_probe(b, depth, score)) return score;
+
+    uint16_t free  = ~Board<4>(b).occupancy();
+    uint8_t  empty = __builtin_popcount(free);
+    float    p     = prob / empty;
+
+    score = 0;
+    for (; free; free &= free - 1) {
+        uint8_t k = __builtin_ctz(free) << 2;
+        score += _PROB_TWO  * _max(b | (1ULL << k), depth, p * _PROB_TWO,  nodes);
+        score += _PROB_FOUR * _max(b | (2ULL << k), depth, p * _PROB_FOUR, nodes);
+    }
+
+    score /= empty;
+
+    _store(b, depth, score);
+
+    return score;
+
+}
+
+bool Solver::best(Board<4> const b, Direction &d, Stats * const stats) {
+
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now();
+
+    // Every (move, empty cell, spawned tile) subtree is a task of its own.
+    struct Branch { uint8_t dir; uint8_t empty; };
+
+    std::vector<Branch>   branches;
+    std::vector<float>    scores;
+    std::vector<float>    probs;
+    std::vector<uint64_t> children;
+
+    Board<4> moves[4];
+    uint8_t  legal = b.moves(moves);
+
+    for (uint8_t k = 0; k < 4; ++k) {
+        if (!(legal & (1 << k))) continue;
+        uint64_t next = moves[k].cells;
+        uint16_t free  = ~Board<4>(next).occupancy();
+        uint8_t  empty = __builtin_popcount(free);
+        branches.push_back({ k, empty });
+        for (; free; free &= free - 1) {
+            uint8_t s = __builtin_ctz(free) << 2;
+            children.push_back(next | (1ULL << s));
+            children.push_back(next | (2ULL << s));
+            probs.push_back(_PROB_TWO  / empty);
+            probs.push_back(_PROB_FOUR / empty);
+        }
+    }
+
+    if (branches.empty()) return false;
+
+    scores.resize(children.size());
+    _nodes = 0;
+
+    std::vector<TaskPool::Task> tasks;
+    for (size_t k = 0; k < children.size(); ++k) {
+        float prob = probs[k];
+        tasks.push_back([this, &scores, &children, k, prob] {
+            uint64_t nodes = 0;
+            scores[k] = _depth > 1 ? _max(children[k], _depth - 1, prob, nodes) : _evaluate(children[k]);
+            _nodes.fetch_add(nodes + 1, std::memory_order_relaxed);
+        });
+    }
+
+    _pool.run(tasks);
+
+    float  top = -1;
+    size_t k   = 0;
+    for (Branch const &br : branches) {
+        float score = 0;
+        for (uint8_t s = 0; s < br.empty; ++s, k += 2) score += _PROB_TWO * scores[k] + _PROB_FOUR * scores[k+1];
+        score /= br.empty;
+        if (score > top) { top = score; d = static_cast<Direction>(br.dir); }
+    }
+
+    if (stats != nullptr) {
+        stats->nodes   = _nodes;
+        stats->seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    return true;
+
+}
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,126 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   Solver.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Multi-threaded expectimax solver (native environment only)
+ *
+ * @note The search alternates player moves and tile spawns, the latter being
+ *       weighted exactly like in `TileArena::spawn()`: a 4 shows up once in ten.
+ *       Spawn subtrees below the root are spread across a work-stealing pool
+ *       and every worker shares a lock-free transposition table keyed by the
+ *       packed board, so it only ever plays the classic 4x4 game.
+ * -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Board.h"
+
+class TaskPool {
+
+    public:
+
+        typedef std::function<void()> Task;
+
+        TaskPool(uint8_t const threads);
+        ~TaskPool();
+
+        uint8_t size() const { return _queues.size(); }
+
+        void run(std::vector<Task> &tasks);
+
+    private:
+
+        struct Queue {
+            std::mutex       lock;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<Queue>       _queues;
+        std::vector<std::thread> _workers;
+        std::mutex               _lock;
+        std::condition_variable  _wake;
+        std::atomic<uint32_t>    _pending;
+        uint32_t                 _generation;
+        bool                     _stop;
+
+        void _work(uint8_t const id);
+        void _drain(uint8_t const id);
+        bool _pop(uint8_t const id, Task &task);
+
+};
+
+class Solver {
+
+    public:
+
+        struct Stats {
+            uint64_t nodes;
+            double   seconds;
+            double   nodesPerSecond() const { return seconds > 0 ? nodes / seconds : 0; }
+        };
+
+        Solver(uint8_t const depth, uint8_t const threads = 0);
+
+        uint8_t threads() const { return _pool.size(); }
+
+        bool best(Board<4> const b, Direction &d, Stats * const stats = nullptr);
+
+    private:
+
+        static uint8_t  constexpr _TT_BITS       = 20;
+        static float    constexpr _PROB_CUTOFF   = 1e-4f;
+        static float    constexpr _PROB_TWO      = .9f;
+        static float    constexpr _PROB_FOUR     = .1f;
+
+        struct Entry {
+            std::atomic<uint64_t> check;
+            std::atomic<uint64_t> data;
+        };
+
+        uint8_t               _depth;
+        TaskPool              _pool;
+        std::vector<Entry>    _table;
+        std::atomic<uint64_t> _nodes;
+
+        static float _heuristic[0x10000];
+
+        static void  _initHeuristic();
+        static float _evaluate(uint64_t const b);
+
+        float _max(uint64_t const b, uint8_t const depth, float const prob, uint64_t &nodes);
+        float _chance(uint64_t const b, uint8_t const depth, float const prob, uint64_t &nodes);
+
+        bool _probe(uint64_t const b, uint8_t const depth, float &score);
+        void _store(uint64_t const b, uint8_t const depth, float const score);
+
+};
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,752 @@
+/**
+ * -----------------------------------------------------------------------------
+ * @file   main.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Headless host harness (native environment only)
+ *
+ * @note The real `setup()` and `loop()` are driven with a virtual clock and
+ *       pseudo-random button presses, so that the whole state machine can be
+ *       profiled at full host speed:
+ *
+ *       2048 [-f frames] [-s seed] [-t frame period in ms]
+ *            [-a search depth] [-j threads] [-w log file]
+ *            [-l transfer time per pixel in ns] [-H]
+ *       2048 -r log file
+ *       2048 -b rounds
+ *       2048 -q bursts [-s seed]
+ *       2048 -m games [-p random|greedy|corner] [-s seed] [-j threads]
+ *
+ *       The random presses include [ESC], and every move taken back is
+ *       checked: the board and score must be those seen before that move
+ *       was played, and replaying the move log from its seed through the
+ *       board engine must lead to them as well.
+ *
+ *       With `-a`, the directions are no longer random but picked by the
+ *       expectimax solver, which plays through the very same button path.
+ *
+ *       With `-H`, the random presses of [ACT] turn the hint on and off
+ *       during the game, and the report tells how deep its searches went.
+ *
+ *       With `-l`, frames are presented through a simulated bus that takes
+ *       the given time per pixel, and the report tells how much time the
+ *       transfers took.
+ *
+ *       With `-w`, the move log of every finished game is appended to the
+ *       given file, and `-r` replays such a file through the board engine,
+ *       checking that each game ends with the recorded score and tile.
+ *
+ *       With `-b`, every graphics asset is blitted the given number of
+ *       times from both its former raw layout and its compressed one, and
+ *       the report compares their flash footprints and blit times after
+ *       checking that both layouts draw the very same pixels. Tile zooming
+ *       is timed the same way, the integer blitter against pushRotateZoom(),
+ *       and so is a resting tile, decoded or copied out of the tile atlas.
+ *       The blitter must draw the very pixels of exact center sampling, and
+ *       may differ from pushRotateZoom() by one pixel on an edge. Keep in
+ *       mind that pushRotateZoom() is the float model of the host stand-in,
+ *       not the fixed-point code LovyanGFX runs on the device.
+ *
+ *       With `-q`, directions are pressed in bursts as long as the input
+ *       queue, all within a tick of the game, and each burst is checked to
+ *       be played in the order of the presses, none of them being dropped.
+ *
+ *       With `-m`, no frame is rendered at all: the given number of games
+ *       is played out by a simple policy on every core, and the report
+ *       tells the distributions of scores, highest tiles and game lengths.
+ * -----------------------------------------------------------------------------
+ */
+
+#define ASSETS_RAW
+
+#include <ESPboy.h>
+#include <ESP_EEPROM.h>
+#include <chrono>
+#include <cmath>
+#include <malloc.h>
+#include <new>
+#include <random>
+#include <unistd.h>
+#include <vector>
+#include "Blitter.h"
+#include "Game.h"
+#include "assets.h"
+#include "LatencyDisplay.h"
+#include "Simulator.h"
+#include "Solver.h"
+#include "TileAtlas.h"
+#include "ZoomCache.h"
+
+typedef Board<BOARD_SIZE> Grid;
+
+extern Game<BOARD_SIZE> game;
+
+void setup();
+void loop();
+
+// -----------------------------------------------------------------------------
+// Heap accounting
+// -----------------------------------------------------------------------------
+
+static size_t _heap_live = 0;
+static size_t _heap_peak = 0;
+
+void *operator new(size_t const size) {
+
+    void *p = malloc(size);
+    if (p == nullptr) throw std::bad_alloc();
+
+    _heap_live += malloc_usable_size(p);
+    if (_heap_live > _heap_peak) _heap_peak = _heap_live;
+
+    return p;
+
+}
+
+void operator delete(void *p) noexcept {
+
+    if (p == nullptr) return;
+
+    _heap_live -= malloc_usable_size(p);
+    free(p);
+
+}
+
+void operator delete(void *p, size_t) noexcept { operator delete(p); }
+
+// -----------------------------------------------------------------------------
+// Move logs
+// -----------------------------------------------------------------------------
+
+static void save(FILE * const out, MoveLog const &log) {
+
+    uint32_t seed   = log.seed();
+    uint32_t score  = log.score();
+    uint8_t  higher = log.higher();
+    uint16_t size   = log.size();
+
+    fwrite(&seed,   sizeof(seed),   1, out);
+    fwrite(&score,  sizeof(score),  1, out);
+    fwrite(&higher, sizeof(higher), 1, out);
+    fwrite(&size,   sizeof(size),   1, out);
+    fwrite(log.data(), 1, (size + 3) >> 2, out);
+
+}
+
+static Grid replayed(MoveLog const &log, uint32_t &score) {
+
+    Prng rng(log.seed());
+    Grid b;
+    Grid next[4];
+    uint32_t gain[4];
+
+    b.spawn(rng);
+    b.spawn(rng);
+
+    score = 0;
+
+    for (uint16_t k = 0; k < log.size(); ++k) {
+        uint8_t d = static_cast<uint8_t>(log.move(k));
+        b.moves(next, gain);
+        score += gain[d];
+        b      = next[d];
+        b.spawn(rng);
+    }
+
+    return b;
+
+}
+
+static int replay(char const * const path) {
+
+    FILE *in = fopen(path, "rb");
+    if (in == nullptr) { perror(path); return 1; }
+
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point t0 = Clock::now();
+
+    uint32_t games  = 0;
+    uint32_t failed = 0;
+    uint64_t moves  = 0;
+
+    uint32_t seed, score;
+    uint8_t  higher;
+    uint16_t size;
+    std::vector<uint8_t> data;
+
+    while (fread(&seed,   sizeof(seed),   1, in) == 1 &&
+           fread(&score,  sizeof(score),  1, in) == 1 &&
+           fread(&higher, sizeof(higher), 1, in) == 1 &&
+           fread(&size,   sizeof(size),   1, in) == 1) {
+
+        data.resize((size + 3) >> 2);
+        if (fread(data.data(), 1, data.size(), in) != data.size()) break;
+
+        Prng     rng(seed);
+        Grid     b;
+        Grid     next[4];
+        uint32_t gain[4];
+        uint32_t total = 0;
+        bool     legal = true;
+
+        b.spawn(rng);
+        b.spawn(rng);
+
+        for (uint16_t k = 0; k < size && legal; ++k) {
+            uint8_t d = static_cast<uint8_t>(MoveLog::move(data.data(), k));
+            legal     = b.moves(next, gain) & (1 << d);
+            total    += gain[d];
+            b         = next[d];
+            b.spawn(rng);
+        }
+
+        bool ok = legal && b.moves(next) == 0 && total == score && b.highest() == higher;
+        if (!ok) {
+            printf("game %u (seed %08x): replay ends with %u points and tile %u, log says %u and %u\n",
+                games, seed, total, 1 << b.highest(), score, 1 << higher);
+            failed++;
+        }
+
+        games++;
+        moves += size;
+
+    }
+
+    fclose(in);
+
+    double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    printf("replayed      %u games, %llu moves, %u mismatches\n", games, (unsigned long long)moves, failed);
+    printf("replay speed  %.0f games/s, %.0f moves/s\n", games / seconds, moves / seconds);
+
+    return failed ? 2 : 0;
+
+}
+
+// -----------------------------------------------------------------------------
+// Input bursts
+// -----------------------------------------------------------------------------
+
+static void frame(Button const b, bool const press, uint32_t const ms) {
+
+    if (press) espboy.button.inject(b);
+    loop();
+    host::advance(ms * 1000);
+
+}
+
+static int bursts(uint32_t const rounds, uint32_t const seed) {
+
+    static Button constexpr KEYS[] = { Button::LEFT, Button::UP, Button::RIGHT, Button::DOWN };
+
+    std::mt19937 input(seed);
+    randomSeed(seed);
+
+    setup();
+    game.seed(seed);
+
+    uint32_t failed  = 0;
+    uint32_t pressed = 0;
+    uint32_t played  = 0;
+
+    for (uint32_t r = 0; r < rounds; ++r) {
+
+        // A fresh game is started whenever the last one is over, and the
+        // burst only begins once the board is at rest.
+        for (uint32_t f = 0; !game.playing() || game.input().size(); ++f) frame(Button::ACT, game.waiting() && (f & 1) == 0, 20);
+
+        uint32_t dropped = game.input().dropped();
+        uint16_t from    = game.log().size();
+
+        // As many directions as the queue holds are pressed within a single
+        // tick of the game, each one being held for a 1 ms frame.
+        Direction burst[INPUT_QUEUE_DEPTH];
+        for (uint8_t k = 0; k < INPUT_QUEUE_DEPTH; ++k) {
+            burst[k] = static_cast<Direction>(input() & 3);
+            frame(KEYS[static_cast<uint8_t>(burst[k])], true,  1);
+            frame(KEYS[static_cast<uint8_t>(burst[k])], false, 1);
+        }
+
+        for (uint32_t f = 0; f < 1000 && (game.input().size() || !(game.playing() || game.waiting())); ++f) frame(Button::ACT, false, 20);
+
+        // The game is replayed through the board engine up to the burst, so
+        // that each press can be told whether it should have been played.
+        MoveLog const &log = game.log();
+        Prng     rng(log.seed());
+        Grid     b;
+        Grid     next[4];
+        uint16_t k = 0;
+
+        b.spawn(rng);
+        b.spawn(rng);
+
+        for (; k < from; ++k) {
+            b.moves(next);
+            b = next[static_cast<uint8_t>(log.move(k))];
+            b.spawn(rng);
+        }
+
+        bool ok = game.input().dropped() == dropped;
+        for (uint8_t j = 0; j < INPUT_QUEUE_DEPTH && ok; ++j) {
+            uint8_t d     = static_cast<uint8_t>(burst[j]);
+            uint8_t legal = b.moves(next);
+            if (legal == 0) break;
+            if (!(legal & (1 << d))) continue;
+            ok = k < log.size() && log.move(k) == burst[j];
+            b  = next[d];
+            b.spawn(rng);
+            k++;
+        }
+
+        ok = ok && k == log.size();
+        if (!ok) {
+            printf("burst %u (seed %08x): %u of %u presses played, %u dropped\n",
+                r, log.seed(), log.size() - from, INPUT_QUEUE_DEPTH, game.input().dropped() - dropped);
+            failed++;
+        }
+
+        pressed += INPUT_QUEUE_DEPTH;
+        played  += log.size() - from;
+
+    }
+
+    printf("input bursts  %u bursts of %u presses, %u moves played, %u mismatches\n", rounds, INPUT_QUEUE_DEPTH, played, failed);
+    printf("              %u presses, %.1f%% of them legal moves\n", pressed, pressed ? 100. * played / pressed : 0);
+
+    return failed ? 2 : 0;
+
+}
+
+// -----------------------------------------------------------------------------
+// Asset benchmark
+// -----------------------------------------------------------------------------
+
+template <typename Blit>
+static double timeBlit(LGFX_Sprite &fb, uint32_t const rounds, Blit const &blit) {
+
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point t0 = Clock::now();
+
+    for (uint32_t r = 0; r < rounds; ++r) blit(fb);
+
+    return std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / rounds;
+
+}
+
+template <typename Raw, typename Packed>
+static bool benchAsset(char const * const name, size_t const raw_bytes, size_t const packed_bytes, uint32_t const rounds, Raw const &raw, Packed const &packed) {
+
+    LGFX_Sprite a, b;
+    a.createSprite(TFT_WIDTH, TFT_WIDTH);
+    b.createSprite(TFT_WIDTH, TFT_WIDTH);
+
+    raw(a);
+    packed(b);
+
+    bool same = memcmp(a.getBuffer(), b.getBuffer(), TFT_WIDTH * TFT_WIDTH * sizeof(uint16_t)) == 0;
+
+    double raw_ns    = timeBlit(a, rounds, raw);
+    double packed_ns = timeBlit(b, rounds, packed);
+
+    printf("%-13s %6zu %8zu %9.0f %11.0f   %s\n", name, raw_bytes, packed_bytes, raw_ns, packed_ns, same ? "identical" : "MISMATCH");
+
+    return same;
+
+}
+
+static int bench(uint32_t const rounds) {
+
+    uint8_t constexpr LABELS = sizeof(POWER_OF_TWO_OFFSET) / sizeof(POWER_OF_TWO_OFFSET[0]);
+
+    printf("asset         flash bytes       ns per blit\n");
+    printf("                 raw   packed       raw      packed\n");
+
+    bool ok = true;
+
+    ok &= benchAsset("logo", sizeof(M1CR0LAB_RAW), sizeof(M1CR0LAB_PALETTE) + sizeof(M1CR0LAB), rounds,
+        [](LGFX_Sprite &fb) { fb.pushImage(45, 17, M1CR0LAB_SIZE, M1CR0LAB_SIZE, M1CR0LAB_RAW, M1CR0LAB_TRANS_COLOR); },
+        [](LGFX_Sprite &fb) { Blitter::image(&fb, 45, 17, M1CR0LAB_SIZE, M1CR0LAB_SIZE, M1CR0LAB_PALETTE, M1CR0LAB, M1CR0LAB_TRANS_COLOR); }
+    );
+
+    ok &= benchAsset("tile", sizeof(TILE_RAW), sizeof(TILE), rounds,
+        [](LGFX_Sprite &fb) { fb.drawBitmap(-3, 50, TILE_RAW, TILE_SIZE, TILE_SIZE, 0xffff); },
+        [](LGFX_Sprite &fb) { Blitter::spans(&fb, -3, 50, TILE, 0xffff); }
+    );
+
+    ok &= benchAsset("labels", sizeof(POWER_OF_TWO_RAW), sizeof(POWER_OF_TWO_OFFSET) + sizeof(POWER_OF_TWO), rounds,
+        [](LGFX_Sprite &fb) {
+            for (uint8_t p = 0; p < LABELS; ++p) fb.drawBitmap((p & 3) * 30, (p >> 2) * 20, POWER_OF_TWO_RAW + p * POWER_OF_TWO_FRAME_SIZE, POWER_OF_TWO_WIDTH, POWER_OF_TWO_HEIGHT, 0xffff);
+        },
+        [](LGFX_Sprite &fb) {
+            for (uint8_t p = 0; p < LABELS; ++p) Blitter::trimmed(&fb, (p & 3) * 30, (p >> 2) * 20, POWER_OF_TWO_WIDTH, POWER_OF_TWO + POWER_OF_TWO_OFFSET[p], 0xffff);
+        }
+    );
+
+    printf("\nzoom          ns per blit\n");
+    printf("              float   integer\n");
+
+    // The tile as it is composited before being zoomed, with its corners
+    // left transparent.
+    LGFX_Sprite tile;
+    tile.createSprite(TILE_SIZE, TILE_SIZE);
+    tile.setColorDepth(8);
+    tile.clear(ZoomCache::TRANSPARENT);
+    Blitter::spans(&tile, 0, 0, TILE, 11);
+    Blitter::trimmed(&tile, 2, 5, POWER_OF_TWO_WIDTH, POWER_OF_TWO + POWER_OF_TWO_OFFSET[10], 20);
+
+    LGFX_Sprite a, b, e;
+    a.createSprite(TFT_WIDTH, TFT_WIDTH);
+    b.createSprite(TFT_WIDTH, TFT_WIDTH);
+    e.createSprite(TFT_WIDTH, TFT_WIDTH);
+    a.setColorDepth(8);
+    b.setColorDepth(8);
+    e.setColorDepth(8);
+
+    uint32_t off     = 0;
+    uint32_t far     = 0;
+    uint32_t inexact = 0;
+    for (uint16_t zoom = 25; zoom < 256; ++zoom) {
+
+        a.clear(0);
+        b.clear(0);
+        e.clear(0);
+
+        float z = zoom / 100.f;
+        tile.pushRotateZoom(&a, 64, 61, 0, z, z, ZoomCache::TRANSPARENT);
+        Blitter::zoomed(&b, tile, zoom, 64, 61, ZoomCache::TRANSPARENT);
+
+        // The sampling the blitter is meant to implement, written out in
+        // doubles: the center of each destination pixel is taken back to
+        // the source, whose middle lies on the corner (64,61), and samples
+        // the source pixel it falls in. The scale is kept as zoom / 100
+        // without rounding it first, so that a center landing right on a
+        // source edge is resolved the exact way, and the blitter must draw
+        // the very same pixels.
+        for (int16_t y = 0; y < TFT_WIDTH; ++y) {
+            int32_t sy = floor((y + .5 - 61) * 100 / zoom + TILE_SIZE * .5);
+            if (sy < 0 || sy >= TILE_SIZE) continue;
+            for (int16_t x = 0; x < TFT_WIDTH; ++x) {
+                int32_t sx = floor((x + .5 - 64) * 100 / zoom + TILE_SIZE * .5);
+                if (sx < 0 || sx >= TILE_SIZE) continue;
+                uint32_t c = tile.readPixel(sx, sy);
+                if (c != ZoomCache::TRANSPARENT) e.drawPixel(x, y, c);
+            }
+        }
+
+        inexact += memcmp(e.getBuffer(), b.getBuffer(), TFT_WIDTH * TFT_WIDTH) != 0;
+
+        // The float sampling of the host stand-in follows the same rule,
+        // but with the scale rounded to a float, so a center lying on a
+        // source edge may fall on either side of it and shift that edge
+        // by one pixel. Anything farther is a mismatch. It says nothing of
+        // LovyanGFX's own fixed-point code, which rounds its own way.
+        for (int16_t y = 0; y < TFT_WIDTH; ++y) {
+            for (int16_t x = 0; x < TFT_WIDTH; ++x) {
+                uint32_t c = b.readPixel(x, y);
+                if (a.readPixel(x, y) == c) continue;
+                bool near = false;
+                for (int8_t dy = -1; dy <= 1; ++dy) {
+                    for (int8_t dx = -1; dx <= 1; ++dx) near |= a.readPixel(x + dx, y + dy) == c;
+                }
+                off++;
+                far += !near;
+            }
+        }
+
+        // The scales the arising and collapsing tiles go through.
+        static uint8_t const SHOWN[] = { 50, 75, 87, 93, 96, 98, 103, 106, 112, 125, 150 };
+        if (memchr(SHOWN, zoom, sizeof(SHOWN)) == nullptr) continue;
+
+        double float_ns   = timeBlit(a, rounds, [&](LGFX_Sprite &fb) { tile.pushRotateZoom(&fb, 64, 61, 0, z, z, ZoomCache::TRANSPARENT); });
+        double integer_ns = timeBlit(b, rounds, [&](LGFX_Sprite &fb) { Blitter::zoomed(&fb, tile, zoom, 64, 61, ZoomCache::TRANSPARENT); });
+
+        printf("%3u%%      %9.0f %9.0f\n", zoom, float_ns, integer_ns);
+
+    }
+
+    if (inexact)  printf("scales 25-255 MISMATCH with exact center sampling (%u scales)\n", inexact);
+    else          printf("scales 25-255 identical to exact center sampling\n");
+
+    if (far)      printf("scales 25-255 MISMATCH with the float model (%u px)\n", far);
+    else if (off) printf("scales 25-255 identical to the float model within one pixel (%u px off)\n", off);
+    else          printf("scales 25-255 identical to the float model\n");
+
+    ok &= inexact == 0 && far == 0;
+
+    // A resting tile, decoded from its assets or copied out of the atlas.
+    TileAtlas::begin();
+    TileAtlas::Glyph const *g = TileAtlas::insert(11, tile);
+
+    a.clear(0);
+    b.clear(0);
+
+    double decoded_ns = timeBlit(a, rounds, [](LGFX_Sprite &fb) {
+        Blitter::spans(&fb, 50, 50, TILE, 11);
+        Blitter::trimmed(&fb, 52, 55, POWER_OF_TWO_WIDTH, POWER_OF_TWO + POWER_OF_TWO_OFFSET[10], 20);
+    });
+    double atlas_ns = timeBlit(b, rounds, [g](LGFX_Sprite &fb) { TileAtlas::blit(&fb, g, 50, 50); });
+
+    bool same = memcmp(a.getBuffer(), b.getBuffer(), TFT_WIDTH * TFT_WIDTH) == 0;
+
+    printf("\ntile          ns per blit\n");
+    printf("            decoded     atlas\n");
+    printf("2048      %9.0f %9.0f   %s\n", decoded_ns, atlas_ns, same ? "identical" : "MISMATCH");
+
+    ok &= same;
+
+    return ok ? 0 : 2;
+
+}
+
+// -----------------------------------------------------------------------------
+// Harness
+// -----------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+
+    uint32_t frames = 100000;
+    uint32_t seed   = 1;
+    uint32_t period = 20;
+    uint8_t  depth  = 0;
+    uint8_t  jobs   = 0;
+    FILE    *record = nullptr;
+    uint64_t batch  = 0;
+    uint32_t bus    = 0;
+    bool     hints  = false;
+    uint32_t check  = 0;
+    char const *rule = "random";
+
+    int opt;
+    while ((opt = getopt(argc, argv, "f:s:t:a:j:w:r:m:p:l:b:q:H")) != -1) {
+        switch (opt) {
+            case 'f': frames = strtoul(optarg, nullptr, 10); break;
+            case 's': seed   = strtoul(optarg, nullptr, 10); break;
+            case 't': period = strtoul(optarg, nullptr, 10); break;
+            case 'a': depth  = strtoul(optarg, nullptr, 10); break;
+            case 'j': jobs   = strtoul(optarg, nullptr, 10); break;
+            case 'r': return replay(optarg);
+            case 'b': return bench(strtoul(optarg, nullptr, 10));
+            case 'q': check  = strtoul(optarg, nullptr, 10); break;
+            case 'm': batch  = strtoull(optarg, nullptr, 10); break;
+            case 'p': rule   = optarg; break;
+            case 'l': bus    = strtoul(optarg, nullptr, 10); break;
+            case 'H': hints  = true; break;
+            case 'w':
+                if ((record = fopen(optarg, "ab")) == nullptr) { perror(optarg); return 1; }
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-f frames] [-s seed] [-t period_ms] [-a depth] [-j threads] [-w log] [-l ns_per_pixel] [-H]\n"
+                                "       %s -r log\n"
+                                "       %s -b rounds\n"
+                                "       %s -q bursts [-s seed]\n"
+                                "       %s -m games [-p random|greedy|corner] [-s seed] [-j threads]\n", argv[0], argv[0], argv[0], argv[0], argv[0]);
+                return 1;
+        }
+    }
+
+#if BOARD_SIZE != 4
+    if (depth) { fprintf(stderr, "the solver only plays the 4x4 game\n"); return 1; }
+#endif
+
+    if (check) return bursts(check, seed);
+
+    if (batch) {
+        Simulator::Policy policy = Simulator::policy(rule);
+        if (policy == nullptr) { fprintf(stderr, "unknown policy: %s\n", rule); return 1; }
+        Simulator::run(policy, batch, seed, jobs).print();
+        return 0;
+    }
+
+    static Button constexpr KEYS[] = { Button::LEFT, Button::UP, Button::RIGHT, Button::DOWN, Button::ACT, Button::ESC };
+
+    // What the game showed at each move count of the ongoing game, which an
+    // undo must bring back.
+    struct Position {
+        bool     seen;
+        Grid     board;
+        uint32_t score;
+        uint16_t logged;
+    };
+
+    Solver        *solver = depth ? new Solver(depth, jobs) : nullptr;
+    Solver::Stats  search = { 0, 0 };
+    uint32_t       plans  = 0;
+    Grid           known;
+    Direction      plan   = Direction::LEFT;
+
+    std::mt19937 input(seed);
+    randomSeed(seed);
+
+    LatencyDisplay *display = bus ? new LatencyDisplay(bus) : nullptr;
+
+    setup();
+    game.seed(seed);
+    if (display != nullptr) game.display(display);
+
+    using Clock = std::chrono::steady_clock;
+
+    uint64_t total_ns = 0;
+    uint64_t worst_ns = 0;
+    uint32_t moves    = 0;
+    uint32_t started  = game.games();
+    uint32_t last     = 0;
+    uint32_t undos    = 0;
+    uint32_t wrong    = 0;
+    uint32_t logs     = 0;
+    bool     saved    = false;
+    bool     seen     = false;
+    uint16_t corner   = 0;
+
+    std::vector<Position> past;
+
+    for (uint32_t f = 0; f < frames; ++f) {
+
+        // A button is held for one frame and released on the next one.
+        if ((f & 1) == 0) {
+            if (solver == nullptr) {
+                // Unless asked for, [ACT] is only pressed when the game waits
+                // for it, so that the hint, whose search runs on wall-clock
+                // cycles, never makes the frames differ from run to run.
+                // [ESC] comes once in 16 presses, so that games still get
+                // to their end.
+                uint32_t k = input() % 80;
+                Button   b = KEYS[k < 75 ? k % 5 : 5];
+                if (hints || b != Button::ACT || (game.waiting() && game.input().size() == 0)) espboy.button.inject(b);
+            } else {
+#if BOARD_SIZE == 4
+                Grid b = game.board();
+                if (game.playing() && game.input().size() == 0 && b != known) {
+                    Solver::Stats s;
+                    if (solver->best(b, plan, &s)) {
+                        search.nodes   += s.nodes;
+                        search.seconds += s.seconds;
+                        plans++;
+                    }
+                    known = b;
+                }
+#endif
+                // The plan only holds for the board it was made for, so it is
+                // never queued while a move is still being played out, and
+                // [ACT] is kept for the screens waiting for a new game.
+                if (game.input().size() == 0) {
+                    if (game.playing())      espboy.button.inject(KEYS[static_cast<uint8_t>(plan)]);
+                    else if (game.waiting()) espboy.button.inject(Button::ACT);
+                }
+            }
+        }
+
+        Clock::time_point t0 = Clock::now();
+        loop();
+        uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+
+        total_ns += ns;
+        if (ns > worst_ns) worst_ns = ns;
+
+        // New games are told apart by the game itself, since taking a move
+        // back lowers the move count as well.
+        if (game.games() != started) {
+            started = game.games();
+            past.clear();
+        } else if (game.moves() > last) moves += game.moves() - last;
+        else if (game.moves() < last) {
+            MoveLog const &log = game.log();
+            Position const &p  = past[game.moves()];
+            bool ok = p.seen && game.board() == p.board && game.score() == p.score;
+            if (!log.truncated()) {
+                uint32_t score;
+                ok = ok && log.size() == p.logged && replayed(log, score) == game.board() && score == game.score();
+            }
+            if (!ok) {
+                printf("undo %u (seed %08x): move %u taken back to a position that was never played\n", undos, log.seed(), game.moves());
+                wrong++;
+            }
+            undos += last - game.moves();
+        }
+        last = game.moves();
+
+        past.resize(last + 1);
+        past[last] = { true, game.board(), game.score(), game.log().size() };
+
+        // The corner of the screen is the background of the board, whose
+        // colour tells whether the frames reach the panel in the byte order
+        // it expects.
+        if (!seen && game.playing()) { corner = espboy.tft.frame[0]; seen = true; }
+
+        if (record != nullptr) {
+            MoveLog const &log = game.log();
+            if (!log.closed()) saved = false;
+            else if (!saved && !log.truncated()) { save(record, log); saved = true; logs++; }
+        }
+
+        host::advance(period * 1000);
+
+    }
+
+    double seconds = total_ns * 1e-9;
+
+    printf("frames        %u (%u ms each, %.1f s of game time)\n", frames, period, frames * period * 1e-3);
+    printf("host time     %.3f s, %.0f frames/s\n", seconds, frames / seconds);
+    printf("ticks         %u us last frame, %u dropped\n", game.frameTime(), game.droppedTicks());
+    printf("frame cost    avg %.1f us, worst %.1f us\n", total_ns * 1e-3 / frames, worst_ns * 1e-3);
+    printf("moves         %u (%.0f moves/s), %u games restarted\n", moves, moves / seconds, started > 0 ? started - 1 : 0);
+    InputQueue::Latency const &latency = game.input().latency();
+    printf("undo          %u moves taken back, %u mismatches\n", undos, wrong);
+    printf("input latency avg %.1f ms, worst %.1f ms over %u moves, %u presses dropped\n", latency.average() * 1e-3, latency.worst * 1e-3, latency.count, game.input().dropped());
+    printf("pixels pushed %.0f per frame\n", (double)espboy.tft.pixels / frames);
+
+    bool colours = !seen || corner == pgm_read_word(PALETTE + 18);
+    if (seen) printf("panel colours %s (background %04x)\n", colours ? "ok" : "WRONG", corner);
+    printf("background    %u bytes, %u distinct rows\n", game.background().bytes(), game.background().rows());
+
+    TileAtlas::Stats const &atlas = TileAtlas::stats();
+    printf("tile atlas    %.1f%% hits, %u evictions, %u glyphs in %u bytes, %u bytes peak\n", atlas.hitRate() * 100, atlas.evictions, atlas.glyphs, atlas.bytes, atlas.peak);
+
+    Hint<BOARD_SIZE>::Stats const &hint = game.hint().stats();
+    printf("hint          %u searches, depth %.2f avg, %u max, %llu nodes, %zu bytes\n", hint.searches, hint.depth(), hint.deepest, (unsigned long long)hint.nodes, sizeof(Hint<BOARD_SIZE>));
+    printf("heap          %zu bytes live, %zu bytes peak\n", _heap_live, _heap_peak);
+    printf("eeprom        %u commits, %u sector erases\n", EEPROM.commits, EEPROM.erases);
+
+    if (display != nullptr) {
+        double sending = display->sending();
+        printf("transfer      %.1f ms sending, %.0f %% of the host time\n", sending * 1e3, 100 * sending / seconds);
+    }
+
+#ifdef PROFILE
+    game.profile();
+#endif
+
+    if (record != nullptr) {
+        printf("move logs     %u games recorded\n", logs);
+        fclose(record);
+    }
+
+    if (solver != nullptr) {
+        printf("solver        depth %u, %u threads, %u decisions, %.2f ms each\n", depth, solver->threads(), plans, plans ? search.seconds * 1e3 / plans : 0);
+        printf("search        %llu nodes, %.0f nodes/s\n", (unsigned long long)search.nodes, search.nodesPerSecond());
+        delete solver;
+    }
+
+    return colours && wrong == 0 ? 0 : 2;
+
+}
+
+/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -20,7 +20,7 @@
 
 #include "Game.h"
 
-Game game;
+Game<BOARD_SIZE> game;
 
 void setup() {
 
@@ -0,0 +1,373 @@
+#!/usr/bin/env python3
+# -----------------------------------------------------------------------------
+# @file   assets.py
+# @author Stéphane Calderoni (https://github.com/m1cr0lab)
+# @brief  Generates include/assets.h from the source images in assets/src
+#
+# @note Nothing but the Python standard library is needed:
+#
+#       python3 tools/assets.py
+#
+#       The splash logo is stored as a small RGB565 palette followed by a
+#       run-length stream of 4-bit palette indices, each byte holding
+#       (length - 1) << 4 | index, runs flowing from one row to the next.
+#
+#       The tile is stored as horizontal spans: it starts with its first
+#       non-blank row and its number of rows, then every row gives its span
+#       count followed by (x, length) pairs, so that it is filled line by
+#       line instead of being scanned bit by bit.
+#
+#       The power-of-two labels remain 1-bit bitmaps, but the blank rows
+#       around each label are dropped: a frame starts with its first row and
+#       its number of rows, and an offset table locates the frames.
+#
+#       The former uncompressed arrays are emitted as well, behind
+#       `ASSETS_RAW`, so that the host harness can compare both layouts
+#       (see `2048 -b`). They never reach the flash otherwise.
+# -----------------------------------------------------------------------------
+
+import os
+import struct
+import sys
+import zlib
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+SRC  = os.path.join(ROOT, 'assets', 'src')
+DST  = os.path.join(ROOT, 'include', 'assets.h')
+
+POWER_OF_TWO_HEIGHT = 17
+M1CR0LAB_TRANS      = 0x1ff8
+
+PALETTE_LABELS = [str(1 << p if p else 0) for p in range(18)] + ['background', 'dark', 'light', 'black']
+
+FOOTER = '''/**
+ * -----------------------------------------------------------------------------
+ * 2048 Game
+ * -----------------------------------------------------------------------------
+ * Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * -----------------------------------------------------------------------------
+ */'''
+
+# -----------------------------------------------------------------------------
+# PNG reader (8-bit RGB and RGBA, non-interlaced)
+# -----------------------------------------------------------------------------
+
+def read_png(name):
+
+    with open(os.path.join(SRC, name), 'rb') as f: data = f.read()
+
+    if data[:8] != b'\x89PNG\r\n\x1a\n': sys.exit('%s: not a PNG file' % name)
+
+    pos, idat = 8, b''
+    while pos < len(data):
+        size, kind = struct.unpack('>I4s', data[pos:pos+8])
+        body = data[pos+8:pos+8+size]
+        if kind == b'IHDR': w, h, depth, color, _, _, interlace = struct.unpack('>IIBBBBB', body)
+        if kind == b'IDAT': idat += body
+        pos += size + 12
+
+    if depth != 8 or color not in (2, 6) or interlace: sys.exit('%s: only 8-bit RGB(A) is supported' % name)
+
+    bpp, raw = (3, 4)[color == 6], zlib.decompress(idat)
+    stride   = w * bpp
+    rows     = []
+    prev     = bytearray(stride)
+
+    for y in range(h):
+        kind = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if   kind == 1: line[i] = (line[i] + a) & 0xff
+            elif kind == 2: line[i] = (line[i] + b) & 0xff
+            elif kind == 3: line[i] = (line[i] + ((a + b) >> 1)) & 0xff
+            elif kind == 4:
+                p  = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                line[i] = (line[i] + (a if pa <= pb and pa <= pc else b if pb <= pc else c)) & 0xff
+        rows.append([tuple(line[x*bpp:x*bpp+bpp]) + ((255,) if bpp == 3 else ()) for x in range(w)])
+        prev = line
+
+    return w, h, rows
+
+def rgb565(px):
+
+    r, g, b = px[:3]
+
+    return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+
+def swap(c):
+
+    return ((c & 0xff) << 8) | (c >> 8)
+
+# -----------------------------------------------------------------------------
+# Encoders
+# -----------------------------------------------------------------------------
+
+def encode_image(rows):
+
+    colors = [M1CR0LAB_TRANS]
+    stream = []
+
+    for row in rows:
+        for px in row:
+            c = swap(rgb565(px)) if px[3] else M1CR0LAB_TRANS
+            if c not in colors: colors.append(c)
+            stream.append(colors.index(c))
+
+    if len(colors) > 16: sys.exit('too many colors for 4-bit indices')
+
+    runs = []
+    k    = 0
+    while k < len(stream):
+        n = 1
+        while n < 16 and k + n < len(stream) and stream[k + n] == stream[k]: n += 1
+        runs.append((n - 1) << 4 | stream[k])
+        k += n
+
+    return colors, runs
+
+def encode_spans(rows):
+
+    bits = [[px[0] > 127 for px in row] for row in rows]
+    used = [y for y, row in enumerate(bits) if any(row)]
+
+    if not used: return [0, 0]
+
+    top, bottom = used[0], used[-1] + 1
+    out = [top, bottom - top]
+
+    for row in bits[top:bottom]:
+        spans = []
+        x = 0
+        while x < len(row):
+            if row[x]:
+                s = x
+                while x < len(row) and row[x]: x += 1
+                spans += [s, x - s]
+            else: x += 1
+        out += [len(spans) >> 1] + spans
+
+    return out
+
+def encode_trimmed(rows):
+
+    used = [y for y, row in enumerate(rows) if any(px[0] > 127 for px in row)]
+
+    if not used: return [0, 0]
+
+    top, bottom = used[0], used[-1] + 1
+
+    return [top, bottom - top] + pack_bits(rows[top:bottom])
+
+def pack_bits(rows):
+
+    out = []
+    for row in rows:
+        for x in range(0, len(row), 8):
+            byte = 0
+            for i, px in enumerate(row[x:x+8]):
+                if px[0] > 127: byte |= 0x80 >> i
+            out.append(byte)
+
+    return out
+
+# -----------------------------------------------------------------------------
+# Emitter
+# -----------------------------------------------------------------------------
+
+def hexes(values, digits):
+
+    return ', '.join('0x%0*x' % (digits, v) for v in values)
+
+def lines(values, digits, per_line):
+
+    return ',\n'.join('    ' + hexes(values[k:k+per_line], digits) for k in range(0, len(values), per_line))
+
+def main():
+
+    out = []
+    put = out.append
+
+    put('/**')
+    put(' * -----------------------------------------------------------------------------')
+    put(' * @file   assets.h')
+    put(' * @author Stéphane Calderoni (https://github.com/m1cr0lab)')
+    put(' * @brief  Graphics assets')
+    put(' *')
+    put(' * @note Generated by tools/assets.py from the images in assets/src,')
+    put(' *       do not edit by hand. The formats are described in the generator')
+    put(' *       and decoded by the `Blitter`.')
+    put(' * -----------------------------------------------------------------------------')
+    put(' */')
+    put('')
+    put('#pragma once')
+    put('')
+    put('#include <Arduino.h>')
+    put('')
+
+    # Splash logo
+
+    w, h, rows     = read_png('m1cr0lab.png')
+    colors, runs   = encode_image(rows)
+
+    put('uint8_t  constexpr M1CR0LAB_SIZE        = %u;' % w)
+    put('uint16_t constexpr M1CR0LAB_TRANS_COLOR = 0x%04x;' % M1CR0LAB_TRANS)
+    put('')
+    put('uint16_t const constexpr M1CR0LAB_PALETTE[] PROGMEM = {')
+    put('')
+    put(lines(colors, 4, 8))
+    put('')
+    put('};')
+    put('')
+    put('uint8_t const constexpr M1CR0LAB[] PROGMEM = {')
+    put('')
+    put(lines(runs, 2, 16))
+    put('')
+    put('};')
+    put('')
+
+    image = [swap(rgb565(px)) if px[3] else M1CR0LAB_TRANS for row in rows for px in row]
+
+    put('#ifdef ASSETS_RAW')
+    put('')
+    put('uint16_t const constexpr M1CR0LAB_RAW[] PROGMEM = {')
+    put('')
+    put(lines(image, 4, w))
+    put('')
+    put('};')
+    put('')
+    put('#endif')
+    put('')
+
+    # Tile
+
+    w, h, rows = read_png('tile.png')
+    spans      = encode_spans(rows)
+
+    put('uint8_t constexpr TILE_SIZE = %u;' % w)
+    put('')
+    put('uint8_t const constexpr TILE[] PROGMEM = {')
+    put('')
+    put('    ' + hexes(spans[:2], 2) + ',')
+    k, body = 2, []
+    while k < len(spans):
+        n = spans[k]
+        body.append('    ' + hexes(spans[k:k + 1 + 2 * n], 2))
+        k += 1 + 2 * n
+    put(',\n'.join(body))
+    put('')
+    put('};')
+    put('')
+
+    put('#ifdef ASSETS_RAW')
+    put('')
+    put('uint8_t const constexpr TILE_RAW[] PROGMEM = {')
+    put('')
+    put(lines(pack_bits(rows), 2, (w + 7) >> 3))
+    put('')
+    put('};')
+    put('')
+    put('#endif')
+    put('')
+
+    # Power-of-two labels
+
+    w, h, rows = read_png('power-of-two.png')
+    frames     = [rows[k:k + POWER_OF_TWO_HEIGHT] for k in range(0, h, POWER_OF_TWO_HEIGHT)]
+    encoded    = [encode_trimmed(f) for f in frames]
+    offsets    = []
+    total      = 0
+
+    for e in encoded:
+        offsets.append(total)
+        total += len(e)
+
+    put('uint8_t constexpr POWER_OF_TWO_WIDTH  = %u;' % w)
+    put('uint8_t constexpr POWER_OF_TWO_HEIGHT = %u;' % POWER_OF_TWO_HEIGHT)
+    put('')
+    put('uint16_t const constexpr POWER_OF_TWO_OFFSET[] PROGMEM = {')
+    put('')
+    put(lines(offsets, 4, 9))
+    put('')
+    put('};')
+    put('')
+    put('uint8_t const constexpr POWER_OF_TWO[] PROGMEM = {')
+    put('')
+    put(',\n'.join('    /* %6u */ %s' % (1 << (p + 1), hexes(e, 2)) for p, e in enumerate(encoded)))
+    put('')
+    put('};')
+    put('')
+
+    size = ((w + 7) >> 3) * POWER_OF_TWO_HEIGHT
+
+    put('#ifdef ASSETS_RAW')
+    put('')
+    put('uint8_t constexpr POWER_OF_TWO_FRAME_SIZE = %u;' % size)
+    put('')
+    put('uint8_t const constexpr POWER_OF_TWO_RAW[] PROGMEM = {')
+    put('')
+    put(',\n'.join('    /* %6u */ %s' % (1 << (p + 1), hexes(pack_bits(f), 2)) for p, f in enumerate(frames)))
+    put('')
+    put('};')
+    put('')
+    put('#endif')
+    put('')
+
+    # Palette
+
+    w, h, rows = read_png('palette.png')
+    colors     = [rgb565(px) for px in rows[0]]
+    width      = max(len(l) for l in PALETTE_LABELS)
+
+    put('uint8_t constexpr PALETTE_SIZE = %u;' % w)
+    put('')
+    put('uint16_t const constexpr PALETTE[] PROGMEM = {')
+    put('')
+    for k, (c, px) in enumerate(zip(colors, rows[0])):
+        if k == 18: put('')
+        sep = ',' if k < w - 1 else ' '
+        put('    0x%04x%s // %*s => #%02x%02x%02x' % (c, sep, width, PALETTE_LABELS[k], *px[:3]))
+    put('')
+    put('};')
+    put('')
+
+    with open(DST, 'w') as f: f.write('\n'.join(out) + '\n' + FOOTER)
+
+if __name__ == '__main__': main()
+
+# -----------------------------------------------------------------------------
+# 2048 Game
+# -----------------------------------------------------------------------------
+# Copyright (c) 2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+# Copyright (c) 2014 Gabriele Cirulli (https://github.com/gabrielecirulli/2048)
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <https://www.gnu.org/licenses/>.
+# -----------------------------------------------------------------------------
\ No newline at end of file